@@ -0,0 +1,69 @@
+#ifndef CALLOC_ALLOCATOR_HPP
+#define CALLOC_ALLOCATOR_HPP
+
+#pragma once
+#include "IsIntegral.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <limits>
+
+/* calloc_allocator specificities:
+	- memory comes from calloc: already zeroed, big blocks are fresh mmap pages the kernel zeroes lazily
+	- containers that know it (allocates_zeroed) skip writing zeros themselves (ex: ft::vector<int> v(n))
+	- stateless, every instance is interchangeable
+*/
+namespace ft
+{
+	template <class T>
+	class calloc_allocator
+	{
+		public:
+			typedef T value_type;
+			typedef T* pointer;
+			typedef const T* const_pointer;
+			typedef T& reference;
+			typedef const T& const_reference;
+			typedef size_t size_type;
+			typedef ptrdiff_t difference_type;
+			template <class U>
+			struct rebind
+			{
+				typedef calloc_allocator<U> other;
+			};
+		// ==================== Constructors ====================
+			calloc_allocator() {}
+			calloc_allocator(const calloc_allocator&) {}
+			template <class U>
+			calloc_allocator(const calloc_allocator<U>&) {}
+		// ==================== Allocation ====================
+			pointer allocate(size_type n, const void* = 0)
+			{
+				if (n > this->max_size())
+					throw std::bad_alloc();
+				void* p = std::calloc(n ? n : 1, sizeof(T));
+				if (p == NULL)
+					throw std::bad_alloc();
+				return static_cast<pointer>(p);
+			}
+			void deallocate(pointer p, size_type) { std::free(p); }
+			void construct(pointer p, const_reference val) { new (static_cast<void*>(p)) T(val); }
+			void destroy(pointer p) { p->~T(); }
+			size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(T); }
+			pointer address(reference x) const { return &x; }
+			const_pointer address(const_reference x) const { return &x; }
+		// ==================== Comparison ====================
+			template <class U>
+			bool operator==(const calloc_allocator<U>&) const { return true; }
+			template <class U>
+			bool operator!=(const calloc_allocator<U>&) const { return false; }
+	};
+
+	// true if allocate() hands out zero filled memory
+	template <class Alloc>
+	struct allocates_zeroed : public false_type {};
+	template <class T>
+	struct allocates_zeroed<calloc_allocator<T> > : public true_type {};
+}
+
+#endif
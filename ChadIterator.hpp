@@ -3,6 +3,7 @@
 
 #pragma once
 #include <cstddef> // Standard library header for ptrdiff_t and size_t
+#include <iterator> // std tags, mapped to ft ones below
 
 namespace ft
 {
@@ -55,6 +56,43 @@ namespace ft
 		typedef Reference	reference;
 		typedef Category	iterator_category;
 	};
+	// ==================== Iterator_tag ====================
+	// ft tag of any iterator, for tag dispatch: std iterators (std::list, istream_iterator...) carry std tags -> mapped to ft ones
+	template <class Tag>
+	struct ft_iterator_tag { typedef Tag type; };
+	template <>
+	struct ft_iterator_tag<std::input_iterator_tag> { typedef ft::input_iterator_tag type; };
+	template <>
+	struct ft_iterator_tag<std::output_iterator_tag> { typedef ft::output_iterator_tag type; };
+	template <>
+	struct ft_iterator_tag<std::forward_iterator_tag> { typedef ft::forward_iterator_tag type; };
+	template <>
+	struct ft_iterator_tag<std::bidirectional_iterator_tag> { typedef ft::bidirectional_iterator_tag type; };
+	template <>
+	struct ft_iterator_tag<std::random_access_iterator_tag> { typedef ft::random_access_iterator_tag type; };
+#if __cplusplus >= 202002L
+	template <>
+	struct ft_iterator_tag<std::contiguous_iterator_tag> { typedef ft::random_access_iterator_tag type; };
+#endif
+	template <class Iterator>
+	struct iterator_tag
+	{
+		typedef typename ft_iterator_tag<typename ft::iterator_traits<Iterator>::iterator_category>::type type;
+	};
+	// ==================== Distance ====================
+	// O(1) for random access, one walk otherwise (forward iterators can be walked again afterwards)
+	template <class Iterator>
+	typename ft::iterator_traits<Iterator>::difference_type distance(Iterator first, Iterator last, ft::random_access_iterator_tag) { return last - first; }
+	template <class Iterator>
+	typename ft::iterator_traits<Iterator>::difference_type distance(Iterator first, Iterator last, ft::input_iterator_tag)
+	{
+		typename ft::iterator_traits<Iterator>::difference_type n = 0;
+		for (; first != last; ++first)
+			n++;
+		return n;
+	}
+	template <class Iterator>
+	typename ft::iterator_traits<Iterator>::difference_type distance(Iterator first, Iterator last) { return ft::distance(first, last, typename ft::iterator_tag<Iterator>::type()); }
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef EMPLACE_ARGS_HPP
+#define EMPLACE_ARGS_HPP
+
+#pragma once
+#include <new>
+
+/* C++98 stand-in for emplace's Args&&... (0 to 3 arguments)
+	- constructor arguments are captured by const reference
+	- construct(p) replays them with placement new: the element is built right in its final storage
+	- make<T>() returns a T built from them, elided straight into the object it initializes (ex: pair.second)
+	Elements are built with placement new, like allocator_traits::construct does for allocators without a variadic construct
+*/
+namespace ft
+{
+	struct emplace_args0
+	{
+		template <class T>
+		void construct(T* p) const { ::new (static_cast<void*>(p)) T(); }
+		template <class T>
+		T make() const { return T(); }
+	};
+	template <class A1>
+	struct emplace_args1
+	{
+		const A1& a1;
+		explicit emplace_args1(const A1& x1) : a1(x1) {}
+		template <class T>
+		void construct(T* p) const { ::new (static_cast<void*>(p)) T(a1); }
+		template <class T>
+		T make() const { return T(a1); }
+	};
+	template <class A1, class A2>
+	struct emplace_args2
+	{
+		const A1& a1;
+		const A2& a2;
+		emplace_args2(const A1& x1, const A2& x2) : a1(x1), a2(x2) {}
+		template <class T>
+		void construct(T* p) const { ::new (static_cast<void*>(p)) T(a1, a2); }
+		template <class T>
+		T make() const { return T(a1, a2); }
+	};
+	template <class A1, class A2, class A3>
+	struct emplace_args3
+	{
+		const A1& a1;
+		const A2& a2;
+		const A3& a3;
+		emplace_args3(const A1& x1, const A2& x2, const A3& x3) : a1(x1), a2(x2), a3(x3) {}
+		template <class T>
+		void construct(T* p) const { ::new (static_cast<void*>(p)) T(a1, a2, a3); }
+		template <class T>
+		T make() const { return T(a1, a2, a3); }
+	};
+}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef GROWTH_POLICY_HPP
+#define GROWTH_POLICY_HPP
+
+#pragma once
+#include <cstddef>
+
+/* Growth policy of ft::vector: new capacity when size must go past capacity
+	- Num / Den -> geometric factor (2 / 1 doubles, 3 / 2 grows by 1.5x)
+	- RoundBytes -> buffers of at least RoundBytes are rounded up to a multiple of it (ex: 16 = malloc chunk, 4096 = page, 2 MB = huge page)
+	- MaxStepBytes -> once a step would add more than that, growth turns linear (+MaxStepBytes each time)
+	- TrimPercent -> auto-trim: when size drops below TrimPercent % of capacity, the buffer shrinks to size * Num / Den
+	  (hysteresis: after a trim the vector is Den / Num full, far from both the growth and the next trim threshold,
+	  so TrimPercent must stay well below 100 * Den / Num)
+	0 disables rounding / capping / trimming. The result is never below what is required.
+*/
+namespace ft
+{
+	template <size_t Num = 2, size_t Den = 1, size_t RoundBytes = 0, size_t MaxStepBytes = 0, size_t TrimPercent = 0>
+	struct growth_policy
+	{
+		static size_t next_capacity(size_t capacity, size_t required, size_t elem_size)
+		{
+			size_t next = capacity * Num / Den;
+			if (next <= capacity) // 0 or 1 with a factor < 2
+				next = capacity + 1;
+			if (MaxStepBytes != 0 && (next - capacity) * elem_size > MaxStepBytes)
+				next = capacity + (MaxStepBytes / elem_size > 0 ? MaxStepBytes / elem_size : 1);
+			if (next < required)
+				next = required;
+			return round(next, elem_size);
+		}
+		// Capacity to shrink to once size went down, capacity itself when there's nothing to trim
+		static size_t trim_capacity(size_t capacity, size_t size, size_t elem_size)
+		{
+			if (TrimPercent == 0 || size * 100 >= capacity * TrimPercent)
+				return capacity;
+			size_t next = round(size * Num / Den, elem_size);
+			return next < capacity ? next : capacity;
+		}
+		static size_t round(size_t capacity, size_t elem_size)
+		{
+			if (RoundBytes != 0 && capacity * elem_size >= RoundBytes)
+			{
+				size_t bytes = (capacity * elem_size + RoundBytes - 1) / RoundBytes * RoundBytes;
+				capacity = bytes / elem_size;
+			}
+			return capacity;
+		}
+	};
+
+	typedef growth_policy<> doubling_growth; // default (same as libstdc++)
+	typedef growth_policy<3, 2, 16> factor_1_5_growth; // folly / msvc factor, rounded to malloc chunks
+	typedef growth_policy<2, 1, 2 * 1024 * 1024> huge_page_growth; // big buffers: whole 2 MB pages
+	typedef growth_policy<2, 1, 4096, 64 * 1024 * 1024> capped_growth; // doubles up to 64 MB steps, linear after
+	typedef growth_policy<2, 1, 0, 0, 25> trimming_growth; // doubles, shrinks back to half full under 25 %
+}
+
+#endif
@@ -14,6 +14,8 @@ namespace ft
 		typedef integral_constant<T, v> type;
 		operator value_type() const { return value; }
 	};
+	typedef integral_constant<bool, true> true_type;
+	typedef integral_constant<bool, false> false_type;
 	
 	// Default = false, true if T is integral
 	template <class T>
@@ -0,0 +1,35 @@
+#ifndef IS_TRANSPARENT_HPP
+#define IS_TRANSPARENT_HPP
+
+#pragma once
+
+namespace ft
+{
+	/*
+		true if Compare declares an is_transparent typedef (C++14 heterogeneous lookup)
+		-> map lookups then take any K comparable with key_type, without building a key_type
+		K is unused, it only makes the trait depend on the lookup's template parameter
+		so that enable_if rejects the overload (SFINAE) instead of failing the whole map
+	*/
+	template <class Compare, class K = void>
+	struct is_transparent
+	{
+		private:
+			template <class U>
+			static char test(typename U::is_transparent*);
+			template <class U>
+			static long test(...);
+		public:
+			static const bool value = sizeof(test<Compare>(0)) == sizeof(char);
+	};
+
+	// std::less<void> for C++98: compares anything with operator< (ex: std::string key vs const char*)
+	struct transparent_less
+	{
+		typedef void is_transparent;
+		template <class T, class U>
+		bool operator()(const T& lhs, const U& rhs) const { return lhs < rhs; }
+	};
+}
+
+#endif
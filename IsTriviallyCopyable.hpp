@@ -0,0 +1,51 @@
+#ifndef IS_TRIVIALLY_COPYABLE_HPP
+#define IS_TRIVIALLY_COPYABLE_HPP
+
+#pragma once
+#include "IsIntegral.hpp"
+
+namespace ft
+{
+	/*
+		true if copying a T is copying its bytes and destroying it does nothing
+		-> containers may move T around with memcpy / memmove instead of copy-construct + destroy
+		gcc >= 5 && clang know it for any type (ex: plain structs), otherwise only scalars are trusted
+	*/
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5)
+	template <class T>
+	struct is_trivially_copyable : public integral_constant<bool, __is_trivially_copyable(T)> {};
+#else
+	template <class T>
+	struct is_trivially_copyable : public integral_constant<bool, is_integral<T>::value> {};
+	template <class T>
+	struct is_trivially_copyable<T*> : public true_type {};
+	template <>
+	struct is_trivially_copyable<float> : public true_type {};
+	template <>
+	struct is_trivially_copyable<double> : public true_type {};
+	template <>
+	struct is_trivially_copyable<long double> : public true_type {};
+#endif
+
+	/*
+		true if default constructing a T leaves its bytes untouched (ex: int, plain structs of them)
+		-> containers may hand out such elements without writing them (vector::resize_uninitialized)
+	*/
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5)
+	template <class T>
+	struct is_trivially_default_constructible : public integral_constant<bool, __is_trivially_constructible(T)> {};
+#else
+	template <class T>
+	struct is_trivially_default_constructible : public integral_constant<bool, is_integral<T>::value> {};
+	template <class T>
+	struct is_trivially_default_constructible<T*> : public true_type {};
+	template <>
+	struct is_trivially_default_constructible<float> : public true_type {};
+	template <>
+	struct is_trivially_default_constructible<double> : public true_type {};
+	template <>
+	struct is_trivially_default_constructible<long double> : public true_type {};
+#endif
+}
+
+#endif
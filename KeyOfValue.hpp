@@ -0,0 +1,27 @@
+#ifndef KEY_OF_VALUE_HPP
+#define KEY_OF_VALUE_HPP
+
+#pragma once
+
+/* Key extractors: how a tree gets the key it compares out of a stored value
+	- identity -> the value is the key (set-like trees)
+	- select_first -> pair.first is the key (map)
+	Returned by reference: the tree compares keys without copying anything
+*/
+namespace ft
+{
+	template <class T>
+	struct identity
+	{
+		typedef T result_type;
+		const result_type& operator()(const T& x) const { return x; }
+	};
+	template <class Pair>
+	struct select_first
+	{
+		typedef typename Pair::first_type result_type;
+		const result_type& operator()(const Pair& x) const { return x.first; }
+	};
+}
+
+#endif
@@ -0,0 +1,242 @@
+#ifndef LATENCY_PROFILER_HPP
+#define LATENCY_PROFILER_HPP
+
+#pragma once
+#include <cstddef>
+#include <ostream>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define FT_PROFILE_RDTSC
+#else
+#include <time.h>
+#endif
+
+/* Profiler policy of ft::vector / ft::map: latency of their operations
+	- no_profiler (default) -> empty scope, compiled out: no size, no instruction
+	- sampling_profiler<Tag> -> 1 call in sample_every (64 by default) of each operation is timed
+	  (rdtsc on x86, clock_gettime elsewhere) into a log2 histogram, per operation
+	- the profile belongs to the policy type: containers sharing a Tag share it,
+	  give a container its own Tag to get its own numbers (sampling_profiler<Tag>::profile())
+	- reallocations (vector growth) are rare by design and always timed: their histogram
+	  next to push_back / insert tells how much of the tail they explain
+	- nested operations are timed on their own too (ex: insert of an input range at the end -> push_backs)
+	- dump() -> text, dump_json() -> JSON
+*/
+namespace ft
+{
+	enum profile_operation
+	{
+		profile_push_back,
+		profile_pop_back,
+		profile_insert, // insert / emplace / try_emplace / operator[] (map)
+		profile_erase,
+		profile_find, // find / count
+		profile_bound, // lower_bound / upper_bound / equal_range
+		profile_resize, // resize / reserve / shrink_to_fit
+		profile_assign,
+		profile_reallocate, // vector buffer change, always timed
+		profile_operations
+	};
+
+	inline const char* profile_operation_name(size_t op)
+	{
+		static const char* names[profile_operations] = { "push_back", "pop_back", "insert", "erase", "find", "bound", "resize", "assign", "reallocate" };
+		return op < profile_operations ? names[op] : "unknown";
+	}
+
+	// ==================== Clock ====================
+	struct profile_clock
+	{
+#ifdef FT_PROFILE_RDTSC
+		static const char* unit() { return "cycles"; }
+		static unsigned long long now() { return __rdtsc(); }
+#else
+		static const char* unit() { return "ns"; }
+		static unsigned long long now()
+		{
+			timespec ts;
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+			return static_cast<unsigned long long>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+		}
+#endif
+	};
+
+	// ==================== Histogram ====================
+	struct latency_histogram
+	{
+		static const size_t buckets = 64;
+		size_t samples;
+		unsigned long long total;
+		unsigned long long min;
+		unsigned long long max;
+		size_t counts[buckets]; // counts[i] = samples of [2^i, 2^(i + 1)) ticks (0 counted in 0)
+
+		latency_histogram() { this->reset(); }
+		void reset()
+		{
+			this->samples = 0;
+			this->total = 0;
+			this->min = 0;
+			this->max = 0;
+			for (size_t i = 0; i < buckets; i++)
+				this->counts[i] = 0;
+		}
+		static size_t bucket(unsigned long long ticks)
+		{
+			size_t i = 0;
+#if defined(__GNUC__)
+			if (ticks > 1)
+				i = sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(ticks);
+#else
+			while (ticks > 1)
+			{
+				ticks >>= 1;
+				i++;
+			}
+#endif
+			return i;
+		}
+		void record(unsigned long long ticks)
+		{
+			if (this->samples == 0 || ticks < this->min)
+				this->min = ticks;
+			if (ticks > this->max)
+				this->max = ticks;
+			this->samples++;
+			this->total += ticks;
+			this->counts[bucket(ticks)]++;
+		}
+		double mean() const { return this->samples ? static_cast<double>(this->total) / this->samples : 0; }
+		// Upper bound of the bucket holding the q quantile (0.5, 0.99, 0.999...), never above max
+		unsigned long long percentile(double q) const
+		{
+			if (this->samples == 0)
+				return 0;
+			size_t rank = static_cast<size_t>(q * this->samples);
+			size_t seen = 0;
+			for (size_t i = 0; i < buckets; i++)
+			{
+				seen += this->counts[i];
+				if (seen > rank)
+				{
+					unsigned long long bound = (i + 1 < buckets) ? (1ULL << (i + 1)) : this->max;
+					return bound < this->max ? bound : this->max;
+				}
+			}
+			return this->max;
+		}
+	};
+
+	// ==================== Profile ====================
+	struct latency_profile
+	{
+		size_t sample_every; // 1 = every call timed
+		size_t calls[profile_operations];
+		size_t countdown[profile_operations]; // calls left before the next sample
+		latency_histogram latencies[profile_operations];
+
+		latency_profile() : sample_every(64) { this->reset(); }
+		void reset()
+		{
+			for (size_t op = 0; op < profile_operations; op++)
+			{
+				this->calls[op] = 0;
+				this->countdown[op] = 1; // first call of each operation is timed
+				this->latencies[op].reset();
+			}
+		}
+		// Counts the call, true if it's one to time
+		bool sample(profile_operation op)
+		{
+			this->calls[op]++;
+			if (op == profile_reallocate || --this->countdown[op] == 0)
+			{
+				this->countdown[op] = this->sample_every ? this->sample_every : 1;
+				return true;
+			}
+			return false;
+		}
+		void record(profile_operation op, unsigned long long ticks) { this->latencies[op].record(ticks); }
+		void dump(std::ostream& out) const
+		{
+			out << "latencies in " << profile_clock::unit() << ", 1 call in " << this->sample_every << " sampled" << std::endl;
+			for (size_t op = 0; op < profile_operations; op++)
+			{
+				const latency_histogram& h = this->latencies[op];
+				if (this->calls[op] == 0)
+					continue;
+				out << profile_operation_name(op) << ": " << this->calls[op] << " calls, " << h.samples << " samples"
+					<< " | mean " << h.mean() << " | min " << h.min << " | p50 " << h.percentile(0.5) << " | p99 " << h.percentile(0.99)
+					<< " | p99.9 " << h.percentile(0.999) << " | max " << h.max << std::endl;
+				for (size_t i = 0; i < latency_histogram::buckets; i++)
+					if (h.counts[i] != 0)
+						out << "  [" << (1ULL << i) << ", " << (1ULL << i) * 2 << "): " << h.counts[i] << std::endl;
+			}
+		}
+		void dump_json(std::ostream& out) const
+		{
+			out << "{\"unit\": \"" << profile_clock::unit() << "\", \"sample_every\": " << this->sample_every << ", \"operations\": [";
+			bool first = true;
+			for (size_t op = 0; op < profile_operations; op++)
+			{
+				const latency_histogram& h = this->latencies[op];
+				if (this->calls[op] == 0)
+					continue;
+				out << (first ? "" : ", ") << "{\"operation\": \"" << profile_operation_name(op) << "\", \"calls\": " << this->calls[op]
+					<< ", \"samples\": " << h.samples << ", \"mean\": " << h.mean() << ", \"min\": " << h.min
+					<< ", \"p50\": " << h.percentile(0.5) << ", \"p99\": " << h.percentile(0.99) << ", \"p999\": " << h.percentile(0.999)
+					<< ", \"max\": " << h.max << ", \"buckets\": [";
+				bool first_bucket = true;
+				for (size_t i = 0; i < latency_histogram::buckets; i++)
+					if (h.counts[i] != 0)
+					{
+						out << (first_bucket ? "" : ", ") << "[" << (1ULL << i) << ", " << h.counts[i] << "]";
+						first_bucket = false;
+					}
+				out << "]}";
+				first = false;
+			}
+			out << "]}" << std::endl;
+		}
+	};
+
+	// ==================== Policies ====================
+	// Containers open a scope at the top of each profiled operation: typename Profiler::scope profiled(profile_insert);
+	struct no_profiler
+	{
+		struct scope
+		{
+			explicit scope(profile_operation) {}
+		};
+	};
+
+	struct default_profile_tag {};
+
+	template <class Tag = default_profile_tag>
+	struct sampling_profiler
+	{
+		static latency_profile& profile()
+		{
+			static latency_profile p;
+			return p;
+		}
+		class scope
+		{
+			private:
+				profile_operation _op;
+				bool _sampled;
+				unsigned long long _start;
+				scope(const scope&);
+				scope& operator=(const scope&);
+			public:
+				explicit scope(profile_operation op) : _op(op), _sampled(profile().sample(op)), _start(this->_sampled ? profile_clock::now() : 0) {}
+				~scope()
+				{
+					if (this->_sampled)
+						profile().record(this->_op, profile_clock::now() - this->_start);
+				}
+		};
+	};
+}
+
+#endif
@@ -12,10 +12,10 @@ namespace ft
 	{
 		protected:
 			typedef typename ft::iterator<ft::bidirectional_iterator_tag, typename ft::choose<isConst, const typename RedBlackTree::value_type, typename RedBlackTree::value_type>::type> iterator;
-			typename RedBlackTree::rb_node* _ptr;
+			typename RedBlackTree::rb_links* _ptr;
 		public:
 		// ==================== Constructors ====================
-			MapIterator(typename RedBlackTree::rb_node* ptr = NULL) : _ptr(ptr) {}
+			MapIterator(typename RedBlackTree::rb_links* ptr = NULL) : _ptr(ptr) {}
 			MapIterator(const MapIterator<RedBlackTree, isConst>& other) : _ptr(other._ptr) {}
 		// ==================== Destructors ====================
 			~MapIterator() {}
@@ -24,6 +24,11 @@ namespace ft
 			{
 				return MapIterator<RedBlackTree, true>(this->_ptr);
 			}
+		// ==================== Underlying node ====================
+			typename RedBlackTree::rb_links* node() const
+			{
+				return this->_ptr;
+			}
 		// ==================== (=) Operator ====================
 			MapIterator<RedBlackTree, isConst>& operator=(const MapIterator<RedBlackTree, isConst>& other)
 			{
@@ -31,28 +36,25 @@ namespace ft
 				return *this;
 			}
 		// ==================== (*) Operator ====================
+			// dereferenceable iterators are on real nodes (never end()): the link is one
 			typename iterator::reference operator*() const
 			{
-				return this->_ptr->data;
+				return static_cast<typename RedBlackTree::rb_node*>(this->_ptr)->data;
 			}
 		// ==================== (->) Operator ====================
 			typename iterator::pointer operator->() const
 			{
-				return &(this->_ptr->data);
+				return &(static_cast<typename RedBlackTree::rb_node*>(this->_ptr)->data);
 			}
 		// ==================== (++it) Operator ====================
 			MapIterator<RedBlackTree, isConst>& operator++()
 			{
-				if (this->_ptr->color == 2)
-					return (*this);
 				this->_ptr = RedBlackTree::successor_in_order(this->_ptr);
 				return (*this);
 			}
 		// ==================== (--it) Operator ====================
 			MapIterator<RedBlackTree, isConst>& operator--()
 			{
-				if (RedBlackTree::predecessor_in_order(this->_ptr) == NULL)
-					return (*this);
 				this->_ptr = RedBlackTree::predecessor_in_order(this->_ptr);
 				return (*this);
 			}
@@ -5,6 +5,9 @@
 
 namespace ft
 {
+	// tag of the pair constructor building second from emplace arguments (see EmplaceArgs.hpp)
+	struct piecewise_construct_t {};
+
 	template<class T1, class T2>
 	struct pair
 	{
@@ -18,6 +21,9 @@ namespace ft
 		pair() : first(first_type()), second(second_type()) {}
 		// initialization
 		pair(const T1& a, const T2& b) : first(a), second(b) {}
+		// first from a, second built from args (no T2 temporary copied in)
+		template <class Args>
+		pair(const T1& a, const Args& args, piecewise_construct_t) : first(a), second(args.template make<T2>()) {}
 		// copy
 		template<class U, class V>
 		pair(const pair<U, V>& pr) : first(pr.first), second(pr.second) {}
@@ -0,0 +1,178 @@
+#ifndef POOL_ALLOCATOR_HPP
+#define POOL_ALLOCATOR_HPP
+
+#pragma once
+#include <cstddef>
+#include <new>
+#include <limits>
+
+/* pool_allocator specificities:
+	- single objects (n == 1) are carved out of big slabs, n > 1 goes straight to operator new
+	- freed objects go on a free list and are recycled by the next allocate(1)
+	- once every object of the pool is freed (ex: tree clear()), the slabs are released in O(slabs)
+	- copies share the pool, rebinding to another type creates a new one
+	  -> a RedBlackTree rebinding the container allocator to its node type gets its own pool (per-tree slabs)
+*/
+namespace ft
+{
+	template <class T, size_t SlabSize = 65536>
+	class pool_allocator
+	{
+		public:
+			typedef T value_type;
+			typedef T* pointer;
+			typedef const T* const_pointer;
+			typedef T& reference;
+			typedef const T& const_reference;
+			typedef size_t size_type;
+			typedef ptrdiff_t difference_type;
+			template <class U>
+			struct rebind
+			{
+				typedef pool_allocator<U, SlabSize> other;
+			};
+		private:
+			template <class U, size_t S>
+			friend class pool_allocator;
+			struct free_slot { free_slot* next; };
+			struct slab { slab* next; };
+			struct pool
+			{
+				slab* slabs;
+				free_slot* free_list;
+				char* cursor; // next never used slot of the newest slab
+				char* end;
+				size_t live; // objects currently handed out
+				size_t slab_count;
+				size_t refs; // allocators sharing this pool
+			};
+			// slab header padded so that slots keep the strictest alignment operator new gives
+			static const size_t header_size = (sizeof(slab) + 15) & ~static_cast<size_t>(15);
+			// a slot must hold T or a free list link (sizeof(T) is a multiple of T's alignment)
+			static const size_t slot_size = (sizeof(T) < sizeof(free_slot)) ? sizeof(free_slot) : sizeof(T);
+			static const size_t slots_per_slab = (SlabSize - header_size) / slot_size > 0 ? (SlabSize - header_size) / slot_size : 1;
+			pool* _pool;
+		// ==================== Pool management ====================
+			static pool* new_pool()
+			{
+				pool* p = new pool;
+				p->slabs = NULL;
+				p->free_list = NULL;
+				p->cursor = NULL;
+				p->end = NULL;
+				p->live = 0;
+				p->slab_count = 0;
+				p->refs = 1;
+				return p;
+			}
+			void add_slab()
+			{
+				slab* s = static_cast<slab*>(::operator new(header_size + slots_per_slab * slot_size));
+				s->next = this->_pool->slabs;
+				this->_pool->slabs = s;
+				this->_pool->cursor = reinterpret_cast<char*>(s) + header_size;
+				this->_pool->end = this->_pool->cursor + slots_per_slab * slot_size;
+				this->_pool->slab_count++;
+			}
+			// Everything was given back: drop every slab but the newest one, which starts over empty
+			void recycle()
+			{
+				slab* keep = this->_pool->slabs;
+				if (keep == NULL)
+					return;
+				slab* s = keep->next;
+				while (s != NULL)
+				{
+					slab* next = s->next;
+					::operator delete(s);
+					s = next;
+				}
+				keep->next = NULL;
+				this->_pool->slabs = keep;
+				this->_pool->slab_count = 1;
+				this->_pool->free_list = NULL;
+				this->_pool->cursor = reinterpret_cast<char*>(keep) + header_size;
+				this->_pool->end = this->_pool->cursor + slots_per_slab * slot_size;
+			}
+			void release()
+			{
+				if (--this->_pool->refs != 0)
+					return;
+				slab* s = this->_pool->slabs;
+				while (s != NULL)
+				{
+					slab* next = s->next;
+					::operator delete(s);
+					s = next;
+				}
+				delete this->_pool;
+			}
+		public:
+		// ==================== Constructors / Destructor ====================
+			pool_allocator() : _pool(new_pool()) {}
+			pool_allocator(const pool_allocator& other) : _pool(other._pool) { this->_pool->refs++; }
+			// Rebinding: different object size -> different pool
+			template <class U>
+			pool_allocator(const pool_allocator<U, SlabSize>&) : _pool(new_pool()) {}
+			~pool_allocator() { this->release(); }
+		// ==================== (=) Operator ====================
+			pool_allocator& operator=(const pool_allocator& other)
+			{
+				other._pool->refs++;
+				this->release();
+				this->_pool = other._pool;
+				return *this;
+			}
+		// ==================== Allocation ====================
+			pointer allocate(size_type n, const void* = 0)
+			{
+				if (n != 1)
+					return static_cast<pointer>(::operator new(n * sizeof(T)));
+				void* slot;
+				if (this->_pool->free_list != NULL)
+				{
+					slot = this->_pool->free_list;
+					this->_pool->free_list = this->_pool->free_list->next;
+				}
+				else
+				{
+					if (this->_pool->cursor == this->_pool->end)
+						this->add_slab();
+					slot = this->_pool->cursor;
+					this->_pool->cursor += slot_size;
+				}
+				this->_pool->live++;
+				return static_cast<pointer>(slot);
+			}
+			void deallocate(pointer p, size_type n)
+			{
+				if (p == NULL)
+					return;
+				if (n != 1)
+				{
+					::operator delete(p);
+					return;
+				}
+				free_slot* slot = reinterpret_cast<free_slot*>(p);
+				slot->next = this->_pool->free_list;
+				this->_pool->free_list = slot;
+				if (--this->_pool->live == 0)
+					this->recycle();
+			}
+			void construct(pointer p, const_reference val) { new (static_cast<void*>(p)) T(val); }
+			void destroy(pointer p) { p->~T(); }
+			size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(T); }
+			pointer address(reference x) const { return &x; }
+			const_pointer address(const_reference x) const { return &x; }
+		// ==================== Pool statistics ====================
+			size_type slab_count() const { return this->_pool->slab_count; }
+			size_type live_count() const { return this->_pool->live; }
+		// ==================== Comparison ====================
+			template <class U>
+			bool operator==(const pool_allocator<U, SlabSize>& other) const { return static_cast<const void*>(this->_pool) == static_cast<const void*>(other._pool); }
+			template <class U>
+			bool operator!=(const pool_allocator<U, SlabSize>& other) const { return !(*this == other); }
+	};
+}
+
+#endif
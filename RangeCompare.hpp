@@ -0,0 +1,266 @@
+#ifndef RANGE_COMPARE_HPP
+#define RANGE_COMPARE_HPP
+
+#pragma once
+#include "IsIntegral.hpp"
+#include "Choose.hpp"
+#include <cstring>
+#include <climits>
+#if defined(__GNUC__) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && (defined(__AVX__) || defined(__AVX2__))
+#include <immintrin.h>
+#endif
+
+/* Equality / lexicographic order of two contiguous ranges (vector relational operators)
+	- bytes -> unsigned char, bool (and char where it's unsigned): memcmp for both
+	- integral -> memcmp for equality, first differing byte (SSE2 / AVX2) gives the first differing element
+	- floating -> float / double compared 4 to 8 at a time (SSE2 / AVX), NaN behaves like the scalar loop
+	- generic -> element by element
+	SIMD kernels are picked at compile time (-msse2 is x86_64's default, -mavx2 / -march=native for AVX2),
+	any other target uses the scalar loops
+*/
+namespace ft
+{
+	struct bytes_compare_tag {};
+	struct integral_compare_tag {};
+	struct floating_compare_tag {};
+	struct generic_compare_tag {};
+
+	template <class T>
+	struct compare_category
+	{
+		typedef typename choose<is_integral<T>::value, integral_compare_tag, generic_compare_tag>::type type;
+	};
+	template <>
+	struct compare_category<unsigned char> { typedef bytes_compare_tag type; };
+	template <>
+	struct compare_category<bool> { typedef bytes_compare_tag type; };
+	template <>
+	struct compare_category<char> { typedef choose<CHAR_MIN == 0, bytes_compare_tag, integral_compare_tag>::type type; };
+	template <>
+	struct compare_category<float> { typedef floating_compare_tag type; };
+	template <>
+	struct compare_category<double> { typedef floating_compare_tag type; };
+
+	// ==================== Kernels ====================
+	// Index of the first differing byte, n if none
+	inline size_t first_byte_mismatch(const unsigned char *a, const unsigned char *b, size_t n)
+	{
+		size_t i = 0;
+#if defined(__GNUC__) && defined(__AVX2__)
+		for (; i + 32 <= n; i += 32)
+		{
+			__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+			__m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+			unsigned int diff = ~static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+			if (diff != 0)
+				return i + __builtin_ctz(diff);
+		}
+#endif
+#if defined(__GNUC__) && defined(__SSE2__)
+		for (; i + 16 <= n; i += 16)
+		{
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+			__m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+			unsigned int diff = ~static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) & 0xFFFFu;
+			if (diff != 0)
+				return i + __builtin_ctz(diff);
+		}
+#endif
+		for (; i < n; i++)
+			if (a[i] != b[i])
+				return i;
+		return n;
+	};
+
+	// Index of the first i with a[i] < b[i] || b[i] < a[i], n if none (unordered NaN pairs are skipped)
+	template <class T>
+	size_t first_order_mismatch(const T *a, const T *b, size_t n, size_t i = 0)
+	{
+		for (; i < n; i++)
+			if (a[i] < b[i] || b[i] < a[i])
+				return i;
+		return n;
+	};
+	inline size_t first_order_mismatch(const float *a, const float *b, size_t n)
+	{
+		size_t i = 0;
+#if defined(__GNUC__) && defined(__AVX__)
+		for (; i + 8 <= n; i += 8)
+		{
+			__m256 x = _mm256_loadu_ps(a + i);
+			__m256 y = _mm256_loadu_ps(b + i);
+			int diff = _mm256_movemask_ps(_mm256_or_ps(_mm256_cmp_ps(x, y, _CMP_LT_OQ), _mm256_cmp_ps(x, y, _CMP_GT_OQ)));
+			if (diff != 0)
+				return i + __builtin_ctz(diff);
+		}
+#endif
+#if defined(__GNUC__) && defined(__SSE2__)
+		for (; i + 4 <= n; i += 4)
+		{
+			__m128 x = _mm_loadu_ps(a + i);
+			__m128 y = _mm_loadu_ps(b + i);
+			int diff = _mm_movemask_ps(_mm_or_ps(_mm_cmplt_ps(x, y), _mm_cmpgt_ps(x, y)));
+			if (diff != 0)
+				return i + __builtin_ctz(diff);
+		}
+#endif
+		return first_order_mismatch<float>(a, b, n, i);
+	};
+	inline size_t first_order_mismatch(const double *a, const double *b, size_t n)
+	{
+		size_t i = 0;
+#if defined(__GNUC__) && defined(__AVX__)
+		for (; i + 4 <= n; i += 4)
+		{
+			__m256d x = _mm256_loadu_pd(a + i);
+			__m256d y = _mm256_loadu_pd(b + i);
+			int diff = _mm256_movemask_pd(_mm256_or_pd(_mm256_cmp_pd(x, y, _CMP_LT_OQ), _mm256_cmp_pd(x, y, _CMP_GT_OQ)));
+			if (diff != 0)
+				return i + __builtin_ctz(diff);
+		}
+#endif
+#if defined(__GNUC__) && defined(__SSE2__)
+		for (; i + 2 <= n; i += 2)
+		{
+			__m128d x = _mm_loadu_pd(a + i);
+			__m128d y = _mm_loadu_pd(b + i);
+			int diff = _mm_movemask_pd(_mm_or_pd(_mm_cmplt_pd(x, y), _mm_cmpgt_pd(x, y)));
+			if (diff != 0)
+				return i + __builtin_ctz(diff);
+		}
+#endif
+		return first_order_mismatch<double>(a, b, n, i);
+	};
+
+	// Index of the first i with a[i] != b[i], n if none (NaN is never equal)
+	template <class T>
+	size_t first_inequality(const T *a, const T *b, size_t n, size_t i = 0)
+	{
+		for (; i < n; i++)
+			if (a[i] != b[i])
+				return i;
+		return n;
+	};
+	inline size_t first_inequality(const float *a, const float *b, size_t n)
+	{
+		size_t i = 0;
+#if defined(__GNUC__) && defined(__AVX__)
+		for (; i + 8 <= n; i += 8)
+		{
+			int diff = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), _CMP_NEQ_UQ));
+			if (diff != 0)
+				return i + __builtin_ctz(diff);
+		}
+#endif
+#if defined(__GNUC__) && defined(__SSE2__)
+		for (; i + 4 <= n; i += 4)
+		{
+			int diff = _mm_movemask_ps(_mm_cmpneq_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+			if (diff != 0)
+				return i + __builtin_ctz(diff);
+		}
+#endif
+		return first_inequality<float>(a, b, n, i);
+	};
+	inline size_t first_inequality(const double *a, const double *b, size_t n)
+	{
+		size_t i = 0;
+#if defined(__GNUC__) && defined(__AVX__)
+		for (; i + 4 <= n; i += 4)
+		{
+			int diff = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), _CMP_NEQ_UQ));
+			if (diff != 0)
+				return i + __builtin_ctz(diff);
+		}
+#endif
+#if defined(__GNUC__) && defined(__SSE2__)
+		for (; i + 2 <= n; i += 2)
+		{
+			int diff = _mm_movemask_pd(_mm_cmpneq_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+			if (diff != 0)
+				return i + __builtin_ctz(diff);
+		}
+#endif
+		return first_inequality<double>(a, b, n, i);
+	};
+
+	// ==================== Equality ====================
+	template <class T>
+	bool range_equal(const T *a, const T *b, size_t n, bytes_compare_tag)
+	{
+		return n == 0 || std::memcmp(a, b, n * sizeof(T)) == 0;
+	};
+	// same bytes <=> same value for integers
+	template <class T>
+	bool range_equal(const T *a, const T *b, size_t n, integral_compare_tag)
+	{
+		return n == 0 || std::memcmp(a, b, n * sizeof(T)) == 0;
+	};
+	// +0.0 == -0.0 and NaN != NaN: bytes can't tell
+	template <class T>
+	bool range_equal(const T *a, const T *b, size_t n, floating_compare_tag)
+	{
+		return first_inequality(a, b, n) == n;
+	};
+	template <class T>
+	bool range_equal(const T *a, const T *b, size_t n, generic_compare_tag)
+	{
+		return first_inequality<T>(a, b, n) == n;
+	};
+	template <class T>
+	bool range_equal(const T *a, const T *b, size_t n)
+	{
+		return range_equal(a, b, n, typename compare_category<T>::type());
+	};
+
+	// ==================== Lexicographic order ====================
+	// < 0 if [a, a + na) < [b, b + nb), 0 if equivalent, > 0 otherwise
+	inline int length_order(size_t na, size_t nb)
+	{
+		return (na < nb) ? -1 : (nb < na);
+	};
+	template <class T>
+	int range_compare(const T *a, size_t na, const T *b, size_t nb, bytes_compare_tag)
+	{
+		size_t n = (na < nb) ? na : nb;
+		int diff = (n == 0) ? 0 : std::memcmp(a, b, n * sizeof(T));
+		return (diff != 0) ? diff : length_order(na, nb);
+	};
+	template <class T>
+	int range_compare(const T *a, size_t na, const T *b, size_t nb, integral_compare_tag)
+	{
+		size_t n = (na < nb) ? na : nb;
+		size_t i = first_byte_mismatch(reinterpret_cast<const unsigned char *>(a), reinterpret_cast<const unsigned char *>(b), n * sizeof(T)) / sizeof(T);
+		if (i < n)
+			return (a[i] < b[i]) ? -1 : 1;
+		return length_order(na, nb);
+	};
+	template <class T>
+	int range_compare(const T *a, size_t na, const T *b, size_t nb, floating_compare_tag)
+	{
+		size_t n = (na < nb) ? na : nb;
+		size_t i = first_order_mismatch(a, b, n);
+		if (i < n)
+			return (a[i] < b[i]) ? -1 : 1;
+		return length_order(na, nb);
+	};
+	template <class T>
+	int range_compare(const T *a, size_t na, const T *b, size_t nb, generic_compare_tag)
+	{
+		size_t n = (na < nb) ? na : nb;
+		size_t i = first_order_mismatch<T>(a, b, n);
+		if (i < n)
+			return (a[i] < b[i]) ? -1 : 1;
+		return length_order(na, nb);
+	};
+	template <class T>
+	int range_compare(const T *a, size_t na, const T *b, size_t nb)
+	{
+		return range_compare(a, na, b, nb, typename compare_category<T>::type());
+	};
+}
+
+#endif
@@ -12,6 +12,9 @@
 #include <iomanip>
 #include "MapIterator.hpp"
 #include "ReverseIterator.hpp"
+#include "KeyOfValue.hpp"
+#include "EmplaceArgs.hpp"
+#include "TreeStats.hpp"
 #include <functional>
 
 /*
@@ -24,205 +27,383 @@
 	- longest path (alternating red and black) from root to NIL node is no more than twice as long as the shortest path (all black nodes)
 	- 3 operations: insert, delete, search, time complexity: O(log n)
 	- rotation rearranges subtress -> changes structure -> decreases height -> increases performance (doesn't affect order), time complexity: O(1)
+	- Compare orders keys, KeyOfValue gets the key of a stored value (identity by default, pair.first for map)
 */
-template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T> >
+template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T>, class KeyOfValue = ft::identity<T> >
 class RedBlackTree
 {
 	public:
 	// ==================== Typedefs ====================
 		typedef T value_type;
+		typedef typename KeyOfValue::result_type key_type;
 		typedef Allocator allocator_type;
 		typedef Compare data_compare;
-		typedef ft::MapIterator<RedBlackTree<T, Compare, Allocator>, false> iterator;
-		typedef ft::MapIterator<RedBlackTree<T, Compare, Allocator>, true> const_iterator;
+		typedef ft::MapIterator<RedBlackTree<T, Compare, Allocator, KeyOfValue>, false> iterator;
+		typedef ft::MapIterator<RedBlackTree<T, Compare, Allocator, KeyOfValue>, true> const_iterator;
 		typedef ft::ReverseIterator<iterator> reverse_iterator;
 		typedef ft::ReverseIterator<const_iterator> const_reverse_iterator;
 	// ==================== RedBlackTree node structure ====================
-		struct rb_node
+		/*
+			Compact layout:
+			- color (0 -> black | 1 -> red | 2 -> NIL) lives in the 2 low bits of the parent address
+			  (a node holds pointers, so it's at least 4-byte aligned and those bits are always 0)
+			- links first, data last: the 3 links of a node share a cache line whatever the payload
+			-> map<int, int> node: 32 bytes instead of 40
+			- the links are a base of their own: the NIL header is only links, embedded in the tree
+			- like libstdc++'s _Rb_tree_node_base, tree walks only see rb_links*: a link is cast to
+			  rb_node* (value()) only once it's known to be a real node, never the NIL header
+		*/
+		struct rb_links
+		{
+			rb_links* left;
+			rb_links* right;
+			size_t parent_color;
+			// ==================== Parent / color ====================
+			rb_links* get_parent() const { return reinterpret_cast<rb_links*>(this->parent_color & ~static_cast<size_t>(3)); }
+			int get_color() const { return static_cast<int>(this->parent_color & 3); }
+			void set_parent(rb_links* parent) { this->parent_color = reinterpret_cast<size_t>(parent) | (this->parent_color & 3); }
+			void set_color(int color) { this->parent_color = (this->parent_color & ~static_cast<size_t>(3)) | static_cast<size_t>(color); }
+		};
+		struct rb_node : public rb_links
 		{
-			rb_node* parent;
-			rb_node* left;
-			rb_node* right;
 			value_type data;
-			bool color; // 0 -> black | 1 -> red
-			// ==================== Constructors ====================
-			rb_node() : data(), parent(NULL), left(NULL), right(NULL), color(RED) {}
-			rb_node(typename allocator_type::reference v) : data(v), parent(NULL), left(NULL), right(NULL), color(RED) {}
-			rb_node(const rb_node& x) : data(x.data), parent(x.parent), left(x.left), right(x.right), color(x.color) {}
 		};
+		// nodes are allocated through the container allocator rebound to rb_node (ex: ft::pool_allocator -> pooled nodes)
+		typedef typename allocator_type::template rebind<rb_node>::other node_allocator_type;
 	private:
 		allocator_type _alloc;
-		std::allocator<rb_node> _node_alloc;
-		data_compare _comp;
-		rb_node* _root;
-		rb_node* _nil; // NIL node is used to represent the "End" of the tree (Not a real node)
+		node_allocator_type _node_alloc;
+#ifdef FT_RBT_STATS
+		typedef ft::counting_compare<Compare, RedBlackTree> stored_compare; // counts every comparison
+#else
+		typedef Compare stored_compare;
+#endif
+		stored_compare _comp;
+		rb_links* _root;
+		/*
+			NIL node = header of the tree (Not a real node), like libstdc++'s _Rb_tree_header:
+			- NIL->parent = root && root->parent = NIL
+			- NIL->left = leftmost node && NIL->right = rightmost node (NIL itself when empty)
+			- it's the "End" of the tree: begin()/end() are O(1) and --end() is the rightmost node
+			- it never moves, mutations only update the leftmost/rightmost links when they change
+			- it lives in the tree itself (_header): no allocation, end() stays valid across clear(),
+			  and a pooled node allocator sees every node freed once the tree is empty
+			NIL only has the links, no data: _nil is an rb_links*, never cast to rb_node*
+		*/
+		rb_links _header;
+		rb_links* _nil;
+		size_t _size; // element count, kept up to date by every modifier so size() is O(1)
 	// ==================== Private functions ====================
 		rb_node* create_node(const value_type& data = value_type())
 		{
 			rb_node* node = this->_node_alloc.allocate(1);
-			this->_alloc.construct(&(node->data), data);
-			node->parent = NULL;
+			try
+			{
+				this->_alloc.construct(&(node->data), data);
+			}
+			catch (...) // copy of data threw: give the raw node back
+			{
+				this->_node_alloc.deallocate(node, 1);
+				throw;
+			}
 			node->left = NULL;
 			node->right = NULL;
-			node->color = RED;
+			node->parent_color = RED; // no parent yet
 			return node;
 		}
-		// Deletes node = destroys data + deallocates memory
-		void delete_node(rb_node* node)
+		// Same, data built in place from emplace arguments (see EmplaceArgs.hpp)
+		template <class Args>
+		rb_node* create_node_from(const Args& args)
 		{
-			if (node != NULL)
+			rb_node* node = this->_node_alloc.allocate(1);
+			try
 			{
-				if (node == this->_root)
-					this->_root = NULL;
+				args.construct(&(node->data));
+			}
+			catch (...)
+			{
+				this->_node_alloc.deallocate(node, 1);
+				throw;
+			}
+			node->left = NULL;
+			node->right = NULL;
+			node->parent_color = RED;
+			return node;
+		}
+		// Deletes node = destroys data + deallocates memory (real nodes only)
+		void delete_node(rb_links* link)
+		{
+			if (link != NULL)
+			{
+				rb_node* node = static_cast<rb_node*>(link);
 				this->_alloc.destroy(&(node->data));
 				this->_node_alloc.deallocate(node, 1);
 			}
 		}
-		void new_nil()
+		// Data of a real node (never NIL)
+		static value_type& value(rb_links* node) { return static_cast<rb_node*>(node)->data; }
+		static const value_type& value(const rb_links* node) { return static_cast<const rb_node*>(node)->data; }
+		void init_nil()
 		{
-			this->_nil = this->create_node();
-			this->_nil->color = NIL;
+			this->_nil = &this->_header;
+			this->_nil->parent_color = NIL;
+			this->reset_nil();
 		}
-		// Moves NIL node to end of the tree
-		void move_nil()
+		// Empty tree: NIL has no root and is its own leftmost && rightmost
+		void reset_nil()
 		{
-			rb_node* node = this->_root;
-			while (node != NULL && node->right)
-				node = node->right;
-			if (node != NULL && node->right != this->_nil)
-				node->right = this->_nil;
-			this->_nil->parent = node;
+			this->_nil->set_parent(NULL);
+			this->_nil->left = this->_nil;
+			this->_nil->right = this->_nil;
 		}
-		// Hides NIL node (used when inserting and searching in the tree because NIL isn't a real node)
-		void hide_nil()
+		// After a swap: root -> NIL links, an empty tree's NIL points to itself again
+		void relink_header()
 		{
-			if (this->_nil->parent != NULL)
-				this->_nil->parent->right = NULL;
-			this->_nil->parent = NULL;
+			if (this->_root == NULL)
+				this->reset_nil();
+			else
+				this->set_root(this->_root);
 		}
-		// Cool recursive functions
-		size_t size_from_node(rb_node* node) const
+		// Root changes go through here to keep root <-> NIL links in sync
+		void set_root(rb_links* node)
 		{
-			if (node != NULL && node != this->_nil)
-				return(size_from_node(node->left) + size_from_node(node->right) + 1);
-			return 0;
+			this->_root = node;
+			this->_nil->set_parent(node);
+			if (node != NULL)
+				node->set_parent(this->_nil);
 		}
-		void clear_from_node(rb_node* node)
+		static rb_links* leftmost(rb_links* node)
 		{
-			if (node != NULL && node != this->_nil)
+			while (node->left != NULL)
+				node = node->left;
+			return node;
+		}
+		static rb_links* rightmost(rb_links* node)
+		{
+			while (node->right != NULL)
+				node = node->right;
+			return node;
+		}
+		static bool is_black(const rb_links* node) { return node == NULL || node->get_color() == BLACK; }
+		// Cool recursive functions
+		void clear_from_node(rb_links* node)
+		{
+			if (node != NULL)
 			{
 				clear_from_node(node->left);
 				clear_from_node(node->right);
 				this->delete_node(node);
 			}
 		}
+		// Nodes chained by their right links only (insert_range's run before build_sorted)
+		void delete_chain(rb_links* node)
+		{
+			while (node != NULL)
+			{
+				rb_links* next = node->right;
+				this->delete_node(node);
+				node = next;
+			}
+		}
+		// Clones the shape && colors of another tree (empty this) node by node: no comparisons, no rotations
+		// If a value copy throws, every clone is freed and this stays empty (root / size / header untouched)
+		void copy_structure(const RedBlackTree<T, Compare, Allocator, KeyOfValue>& rbt)
+		{
+			if (rbt._root == NULL)
+				return;
+			this->set_root(this->clone_from_node(rbt._root, NULL));
+			this->_nil->left = leftmost(this->_root);
+			this->_nil->right = rightmost(this->_root);
+			this->_size = rbt._size;
+		}
+		rb_links* clone_from_node(const rb_links* node, rb_links* parent)
+		{
+			if (node == NULL)
+				return NULL;
+			rb_node* copy = this->create_node(value(node));
+			copy->set_color(node->get_color());
+			copy->set_parent(parent);
+			try
+			{
+				copy->left = this->clone_from_node(node->left, copy);
+				copy->right = this->clone_from_node(node->right, copy);
+			}
+			catch (...) // a value copy threw below: this partial subtree is freed, the caller frees its own part
+			{
+				this->clear_from_node(copy);
+				throw;
+			}
+			return copy;
+		}
 		// Print binary tree in a nice way :D
-		void printBT(const std::string& prefix, const rb_node* node, bool isLeft) const
+		void printBT(std::ostream& out, const std::string& prefix, const rb_links* node, bool isLeft) const
 		{
-			if (node != nullptr)
+			if (node != NULL)
 			{
-				std::cout << prefix;
-				std::cout << (isLeft ? "|--" : "L--");
-				std::cout << node->data;
-				std::cout << (node->color == RED ? "R" : (node->color == BLACK ? "B" : "N")) << std::endl;
-				printBT(prefix + (isLeft ? "|   " : "    "), node->right, true);
-				printBT(prefix + (isLeft ? "|   " : "    "), node->left, false);
+				out << prefix;
+				out << (isLeft ? "|--" : "L--");
+				out << value(node);
+				out << (node->get_color() == RED ? "R" : (node->get_color() == BLACK ? "B" : "N")) << std::endl;
+				printBT(out, prefix + (isLeft ? "|   " : "    "), node->right, true);
+				printBT(out, prefix + (isLeft ? "|   " : "    "), node->left, false);
 			}
 		}
+		// Black height of node's subtree, -1 (+ reason on out) at the first broken invariant
+		int verify_subtree(const rb_links* node, const rb_links* parent, const value_type* low, const value_type* high, size_t& count, std::ostream& out) const
+		{
+			if (node == NULL)
+				return 0;
+			count++;
+			const char* problem = NULL;
+			if (node->get_parent() != parent)
+				problem = "child doesn't point back to its parent";
+			else if (node->get_color() != RED && node->get_color() != BLACK)
+				problem = "node is neither red nor black";
+			else if ((low != NULL && !this->inferior(*low, value(node))) || (high != NULL && !this->inferior(value(node), *high)))
+				problem = "keys out of order";
+			else if (node->get_color() == RED && ((node->left != NULL && node->left->get_color() == RED) || (node->right != NULL && node->right->get_color() == RED)))
+				problem = "red node with a red child";
+			if (problem != NULL)
+			{
+				this->violation(out, problem, count);
+				return -1;
+			}
+			int left = this->verify_subtree(node->left, node, low, &value(node), count, out);
+			if (left < 0)
+				return -1;
+			int right = this->verify_subtree(node->right, node, &value(node), high, count, out);
+			if (right < 0)
+				return -1;
+			if (left != right)
+			{
+				this->violation(out, "black heights differ", count);
+				return -1;
+			}
+			return left + (node->get_color() == BLACK);
+		}
+		// Always false, for verify() to return it
+		bool violation(std::ostream& out, const char* reason, size_t node_index) const
+		{
+			out << "RedBlackTree::verify: " << reason << " (node " << node_index << " in pre-order)" << std::endl;
+			return false;
+		}
+		// Height below node (counted in nodes) && sum of the depths of its subtree
+		void measure(const rb_links* node, size_t depth, size_t& height, size_t& depth_sum) const
+		{
+			if (node == NULL)
+				return;
+			depth_sum += depth;
+			if (depth + 1 > height)
+				height = depth + 1;
+			this->measure(node->left, depth + 1, height, depth_sum);
+			this->measure(node->right, depth + 1, height, depth_sum);
+		}
 	// ==================== RedBlackTree Rotations ====================
-		void rotate_right(rb_node* X)
+		void rotate_right(rb_links* X)
 		{
-			rb_node* Y = X->left;
+			FT_RBT_STAT(stats().rotations++;)
+			rb_links* Y = X->left;
 			X->left = Y->right;
 			if (Y->right != NULL)
-				Y->right->parent = X;
-			Y->parent = X->parent;
-			if (X->parent == NULL)
-				this->_root = Y;
+				Y->right->set_parent(X);
+			Y->set_parent(X->get_parent());
+			if (X == this->_root)
+				this->set_root(Y);
 			else if (is_right_child(X))
-				X->parent->right = Y;
+				X->get_parent()->right = Y;
 			else
-				X->parent->left = Y;
+				X->get_parent()->left = Y;
 			Y->right = X;
-			X->parent = Y;
+			X->set_parent(Y);
 		}
-		void rotate_left(rb_node* X)
+		void rotate_left(rb_links* X)
 		{
-			rb_node* Y = X->right;
+			FT_RBT_STAT(stats().rotations++;)
+			rb_links* Y = X->right;
 			X->right = Y->left;
 			if (Y->left != NULL)
-				Y->left->parent = X;
-			Y->parent = X->parent;
-			if (X->parent == NULL)
-				this->_root = Y;
+				Y->left->set_parent(X);
+			Y->set_parent(X->get_parent());
+			if (X == this->_root)
+				this->set_root(Y);
 			else if (is_left_child(X))
-				X->parent->left = Y;
+				X->get_parent()->left = Y;
 			else
-				X->parent->right = Y;
+				X->get_parent()->right = Y;
 			Y->left = X;
-			X->parent = Y;
+			X->set_parent(Y);
 		}
 	// ==================== Node family ====================
-		rb_node* parent(rb_node* node) const
+		rb_links* parent(rb_links* node) const
 		{
 			if (node != NULL)
-				return node->parent;
+				return node->get_parent();
 			return NULL;
 		}
-		rb_node* grandparent(rb_node* node)
+		rb_links* grandparent(rb_links* node)
 		{
-			if (node && node->parent && node->parent->parent)
-				return node->parent->parent;
+			if (node && node->get_parent() && node->get_parent()->get_parent())
+				return node->get_parent()->get_parent();
 			return NULL;
 		}
-		rb_node* uncle(rb_node* node)
+		rb_links* uncle(rb_links* node)
 		{
-			rb_node* g = grandparent(node);
+			rb_links* g = grandparent(node);
 			if (g == NULL)
 				return NULL;
-			if (node->parent == g->left)
+			if (node->get_parent() == g->left)
 				return g->right;
 			else
 				return g->left;
 		}
-		rb_node* sibling(rb_node* node)
+		rb_links* sibling(rb_links* node)
 		{
-			if (node == node->parent->left)
-				return node->parent->right;
+			if (node == node->get_parent()->left)
+				return node->get_parent()->right;
 			else
-				return node->parent->left;
+				return node->get_parent()->left;
 		}
-		bool is_left_child(rb_node* node)
+		// root's parent is NIL, whose left/right are leftmost/rightmost: root is never a child
+		bool is_left_child(rb_links* node)
 		{
-			if (node && node->parent)
-				return node == node->parent->left;
+			if (node && node != this->_root)
+				return node == node->get_parent()->left;
 			return false;
 		}
-		bool is_right_child(rb_node* node)
+		bool is_right_child(rb_links* node)
 		{
-			if (node && node->parent)
-				return node == node->parent->right;
+			if (node && node != this->_root)
+				return node == node->get_parent()->right;
 			return false;
 		}
 	// ==================== RedBlackTree modifications ====================
-		void recolor(rb_node* node)
+		// set_color of the rebalancing fixes (counted in stats builds)
+		void paint(rb_links* node, int color)
+		{
+			FT_RBT_STAT(stats().recolors += (node->get_color() != color);)
+			node->set_color(color);
+		}
+		void recolor(rb_links* node)
 		{
-			if (node->color == BLACK)
-				node->color = RED;
-			node->color = BLACK;
+			if (node->get_color() == BLACK)
+				node->set_color(RED);
+			node->set_color(BLACK);
 		}
-		void switch_node(rb_node* base_node, rb_node* switch_node)
+		void switch_node(rb_links* base_node, rb_links* switch_node)
 		{
 			// base_node parent points to switch_node after this
 			if (base_node == this->_root)
-				this->_root = switch_node;
-			else if (base_node == base_node->parent->left)
-				base_node->parent->left = switch_node;
+			{
+				this->set_root(switch_node);
+				return;
+			}
+			else if (base_node == base_node->get_parent()->left)
+				base_node->get_parent()->left = switch_node;
 			else
-				base_node->parent->right = switch_node;
+				base_node->get_parent()->right = switch_node;
 			// switch_node points to base_node parent after this
 			if (switch_node != NULL)
-				switch_node->parent = base_node->parent;
+				switch_node->set_parent(base_node->get_parent());
 		}
 		/*
 			Insertion fix strategy (for a node Z = red):
@@ -232,17 +413,17 @@ class RedBlackTree
 				3. Z.uncle = black (triangle formation with Z && Z.parent && Z.grandparent) -> rotate Z.parent
 				4. Z.uncle = black (line formation with Z && Z.parent && Z.grandparent) -> rotate Z.grandparent && recolor new Z.parent & Z.grandparent
 		*/
-		void insertion_tree_fix(rb_node* Z) // From Z to _root
+		void insertion_tree_fix(rb_links* Z) // From Z to _root
 		{
-			while (parent(Z)->color == RED)
+			while (parent(Z)->get_color() == RED)
 			{
 				if (is_right_child(parent(Z)))
 				{
-					if (uncle(Z) && uncle(Z)->color == RED) // scenario 2
+					if (uncle(Z) && uncle(Z)->get_color() == RED) // scenario 2
 					{
-						uncle(Z)->color = BLACK;
-						parent(Z)->color = BLACK;
-						grandparent(Z)->color = RED;
+						this->paint(uncle(Z), BLACK);
+						this->paint(parent(Z), BLACK);
+						this->paint(grandparent(Z), RED);
 						Z = grandparent(Z);
 					}
 					else // scenario 3 && 4
@@ -252,18 +433,18 @@ class RedBlackTree
 							Z = parent(Z);
 							rotate_right(Z);
 						}
-						parent(Z)->color = BLACK;
-						grandparent(Z)->color = RED;
+						this->paint(parent(Z), BLACK);
+						this->paint(grandparent(Z), RED);
 						rotate_left(grandparent(Z));
 					}
 				}
 				else // mirror scenarios
 				{
-					if (uncle(Z) && uncle(Z)->color == RED) // 2
+					if (uncle(Z) && uncle(Z)->get_color() == RED) // 2
 					{
-						uncle(Z)->color = BLACK;
-						parent(Z)->color = BLACK;
-						grandparent(Z)->color = RED;
+						this->paint(uncle(Z), BLACK);
+						this->paint(parent(Z), BLACK);
+						this->paint(grandparent(Z), RED);
 						Z = grandparent(Z);
 					}
 					else // 3 && 4
@@ -273,18 +454,18 @@ class RedBlackTree
 							Z = parent(Z);
 							rotate_left(Z);
 						}
-						parent(Z)->color = BLACK;
-						grandparent(Z)->color = RED;
+						this->paint(parent(Z), BLACK);
+						this->paint(grandparent(Z), RED);
 						rotate_right(grandparent(Z));
 					}
 				}
 				if (Z == this->_root)
 					break;
 			}
-			this->_root->color = BLACK;
+			this->paint(this->_root, BLACK);
 		}
 		/* 
-			Deletion fix strategy (only for a node Z = black):
+			Deletion fix strategy (only for a node Z = black, Z can be NULL -> a black leaf, hence Z_parent):
 			- 5 scenarios
 				1. Z = root -> done
 				2. Z.sibling = red -> recolor Z.sibling && Z.parent = red && rotate_left Z.parent && Z.sibling = Z.parent.right
@@ -292,148 +473,274 @@ class RedBlackTree
 				4. Z.sibling = black && Z.sibling.left = red && Z.sibling.right = black -> recolor Z.sibling && Z.sibling.left = black && rotate_right Z.sibling && Z.sibling = Z.parent.right
 				5. Z.sibling = black && Z.sibling.right = red -> recolor Z.sibling = Z.parent.color && Z.parent.color = black && Z.sibling.right.color = black && rotate_left Z.parent && Z = root
 		*/
-		void deletion_tree_fix(rb_node* Z) // From Z to _root
+		void deletion_tree_fix(rb_links* Z, rb_links* Z_parent) // From Z to _root
 		{
-			if (Z != NULL)
+			while (Z != this->_root && is_black(Z)) // scenario 1 is automatically handled
 			{
-				while (Z != this->_root && Z->color == BLACK) // scenario 1 is automatically handled
+				if (Z == Z_parent->left)
 				{
-					if (is_left_child(Z))
+					rb_links* S = Z_parent->right;
+					if (S->get_color() == RED) // scenario 2
 					{
-						rb_node* S = sibling(Z);
-						if (S->color == RED) // scenario 2
-						{
-							S->color = BLACK;
-							parent(Z)->color = RED;
-							rotate_left(parent(Z));
-							S = parent(Z)->right;
-						}
-						if (S->left->color == BLACK && S->right->color == BLACK) // scenario 3
-						{
-							S->color = RED;
-							Z = parent(Z);
-						}
-						else // scenario 4 && 5
-						{
-							if (S->right->color == BLACK) // 4
-							{
-								S->left->color = BLACK;
-								S->color = RED;
-								rotate_right(S);
-								S = parent(Z)->right;
-							}
-							S->color = parent(Z)->color; // 5
-							parent(Z)->color = BLACK;
-							S->right->color = BLACK;
-							rotate_left(parent(Z));
-							Z = this->_root;
-						}
+						this->paint(S, BLACK);
+						this->paint(Z_parent, RED);
+						rotate_left(Z_parent);
+						S = Z_parent->right;
 					}
-					else // mirror scenarios
+					if (is_black(S->left) && is_black(S->right)) // scenario 3
 					{
-						rb_node* S = sibling(Z);
-						if (S->color == RED) // 2
-						{
-							S->color = BLACK;
-							parent(Z)->color = RED;
-							rotate_right(parent(Z));
-							S = parent(Z)->left;
-						}
-						if (S->left->color == BLACK && S->right->color == BLACK) // 3
+						this->paint(S, RED);
+						Z = Z_parent;
+						Z_parent = Z_parent->get_parent();
+					}
+					else // scenario 4 && 5
+					{
+						if (is_black(S->right)) // 4
 						{
-							S->color = RED;
-							Z = parent(Z);
+							this->paint(S->left, BLACK);
+							this->paint(S, RED);
+							rotate_right(S);
+							S = Z_parent->right;
 						}
-						else // 4 && 5
+						this->paint(S, Z_parent->get_color()); // 5
+						this->paint(Z_parent, BLACK);
+						this->paint(S->right, BLACK);
+						rotate_left(Z_parent);
+						Z = this->_root;
+					}
+				}
+				else // mirror scenarios
+				{
+					rb_links* S = Z_parent->left;
+					if (S->get_color() == RED) // 2
+					{
+						this->paint(S, BLACK);
+						this->paint(Z_parent, RED);
+						rotate_right(Z_parent);
+						S = Z_parent->left;
+					}
+					if (is_black(S->left) && is_black(S->right)) // 3
+					{
+						this->paint(S, RED);
+						Z = Z_parent;
+						Z_parent = Z_parent->get_parent();
+					}
+					else // 4 && 5
+					{
+						if (is_black(S->left)) // 4
 						{
-							if (S->left->color == BLACK) // 4
-							{
-								S->right->color = BLACK;
-								S->color = RED;
-								rotate_left(S);
-								S = parent(Z)->left;
-							}
-							S->color = parent(Z)->color; // 5
-							parent(Z)->color = BLACK;
-							S->left->color = BLACK;
-							rotate_right(parent(Z));
-							Z = this->_root;
+							this->paint(S->right, BLACK);
+							this->paint(S, RED);
+							rotate_left(S);
+							S = Z_parent->left;
 						}
+						this->paint(S, Z_parent->get_color()); // 5
+						this->paint(Z_parent, BLACK);
+						this->paint(S->left, BLACK);
+						rotate_right(Z_parent);
+						Z = this->_root;
 					}
 				}
-				Z->color = BLACK;
 			}
+			if (Z != NULL)
+				this->paint(Z, BLACK);
+		}
+		// ==================== Insertion helpers ====================
+		// Returns the node with key k, or NULL with parent/left set to the empty slot where k belongs
+		rb_links* find_insert_position(const key_type& k, rb_links*& parent, bool& left) const
+		{
+			rb_links* tmp = this->_root;
+			parent = NULL;
+			left = false;
+			while (tmp != NULL)
+			{
+				parent = tmp;
+				if (this->_comp(k, key(value(tmp))))
+				{
+					left = true;
+					tmp = tmp->left;
+				}
+				else if (this->_comp(key(value(tmp)), k))
+				{
+					left = false;
+					tmp = tmp->right;
+				}
+				else
+					return tmp;
+			}
+			return NULL;
+		}
+		// Same as find_insert_position but tries the neighbours of hint before descending from the root
+		rb_links* find_hint_position(rb_links* hint, const value_type& val, rb_links*& parent, bool& left) const
+		{
+			if (hint == NULL || hint == this->_nil) // end(): only worth it when val goes after the last node
+			{
+				if (this->_size > 0 && this->inferior(value(this->_nil->right), val))
+				{
+					parent = this->_nil->right;
+					left = false;
+					return NULL;
+				}
+			}
+			else if (this->inferior(val, value(hint))) // val goes somewhere before hint
+			{
+				if (hint == this->_nil->left) // hint is the first node, its left slot is free
+				{
+					parent = hint;
+					left = true;
+					return NULL;
+				}
+				rb_links* before = predecessor_in_order(hint);
+				if (this->inferior(value(before), val)) // before < val < hint: one of the two has a free slot
+				{
+					if (before->right == NULL)
+					{
+						parent = before;
+						left = false;
+					}
+					else
+					{
+						parent = hint;
+						left = true;
+					}
+					return NULL;
+				}
+			}
+			else if (this->inferior(value(hint), val)) // val goes somewhere after hint
+			{
+				if (hint == this->_nil->right) // hint is the last node, its right slot is free
+				{
+					parent = hint;
+					left = false;
+					return NULL;
+				}
+				rb_links* after = successor_in_order(hint);
+				if (this->inferior(val, value(after))) // hint < val < after: one of the two has a free slot
+				{
+					if (hint->right == NULL)
+					{
+						parent = hint;
+						left = false;
+					}
+					else
+					{
+						parent = after;
+						left = true;
+					}
+					return NULL;
+				}
+			}
+			else // equal to hint
+				return hint;
+			return this->find_insert_position(key(val), parent, left);
+		}
+		// Hangs Z in the empty slot (parent, left) and rebalances, parent == NULL means empty tree
+		void link_node(rb_links* Z, rb_links* parent, bool left)
+		{
+			this->_size++;
+			if (parent == NULL) // empty tree
+			{
+				Z->set_color(BLACK);
+				this->set_root(Z);
+				this->_nil->left = Z;
+				this->_nil->right = Z;
+				return;
+			}
+			// relation kid -> parent
+			Z->set_parent(parent);
+			// relation parent -> kid (+ NIL if Z is the new first/last node)
+			if (left)
+			{
+				parent->left = Z;
+				if (parent == this->_nil->left)
+					this->_nil->left = Z;
+			}
+			else
+			{
+				parent->right = Z;
+				if (parent == this->_nil->right)
+					this->_nil->right = Z;
+			}
+			this->insertion_tree_fix(Z);
+		}
+		// ==================== Bulk build ====================
+		/*
+			Builds a balanced tree out of n sorted nodes chained through their right pointer
+			- in-order recursion: left half, middle node, right half -> depth of leaves differs by at most 1
+			- every node is black except the ones on the deepest level when it isn't full (red_depth),
+			  which keeps the same black height on every path (same trick as java's TreeMap.buildFromSorted)
+		*/
+		void build_sorted(rb_links* head, size_t n)
+		{
+			if (n == 0)
+				return;
+			size_t red_depth = 0;
+			for (size_t m = n + 1; m > 1; m >>= 1)
+				red_depth++;
+			this->_nil->left = head;
+			this->set_root(this->build_from_list(head, n, 0, red_depth));
+			this->_nil->right = rightmost(this->_root);
+			this->_size = n;
+		}
+		rb_links* build_from_list(rb_links*& list, size_t n, size_t depth, size_t red_depth)
+		{
+			if (n == 0)
+				return NULL;
+			size_t left_n = (n - 1) / 2;
+			rb_links* left = this->build_from_list(list, left_n, depth + 1, red_depth);
+			rb_links* middle = list;
+			list = list->right;
+			middle->left = left;
+			if (left != NULL)
+				left->set_parent(middle);
+			middle->set_color((depth == red_depth) ? RED : BLACK);
+			middle->right = this->build_from_list(list, n - left_n - 1, depth + 1, red_depth);
+			if (middle->right != NULL)
+				middle->right->set_parent(middle);
+			return middle;
 		}
 		// ==================== Comparison ====================
-		bool inferior(const value_type& a, const value_type& b) const { return this->_comp(a, b); }
-		bool superior(const value_type& a, const value_type& b) const { return this->_comp(b, a); }
-		bool equal(const value_type& a, const value_type& b) const { return (!this->_comp(a, b) && !this->_comp(b, a)); }
+		static const key_type& key(const value_type& val) { return KeyOfValue()(val); }
+		bool inferior(const value_type& a, const value_type& b) const { return this->_comp(key(a), key(b)); }
+		bool superior(const value_type& a, const value_type& b) const { return this->_comp(key(b), key(a)); }
+		bool equal(const value_type& a, const value_type& b) const { return (!this->_comp(key(a), key(b)) && !this->_comp(key(b), key(a))); }
 	public :
 		// ==================== Constructors ====================
-		RedBlackTree(const data_compare& compare = data_compare(), const allocator_type& alloc = allocator_type()) : _alloc(alloc), _node_alloc(), _comp(compare), _root(NULL), _nil(NULL) { this->new_nil(); }
-		RedBlackTree(const RedBlackTree<T, Compare, Allocator>& rbt): _alloc(rbt._alloc), _node_alloc(rbt._node_alloc), _comp(rbt._comp), _root(NULL), _nil(NULL)
+		RedBlackTree(const data_compare& compare = data_compare(), const allocator_type& alloc = allocator_type()) : _alloc(alloc), _node_alloc(alloc), _comp(compare), _root(NULL), _nil(NULL), _size(0) { this->init_nil(); }
+		RedBlackTree(const RedBlackTree<T, Compare, Allocator, KeyOfValue>& rbt): _alloc(rbt._alloc), _node_alloc(rbt._alloc), _comp(rbt._comp), _root(NULL), _nil(NULL), _size(0)
 		{
-			this->new_nil();
-			for (const_iterator it = rbt.begin(); it != rbt.end(); ++it)
-				this->insert(*it);
+			this->init_nil();
+			this->copy_structure(rbt);
 		}
 		// ==================== Destructor ====================
 		~RedBlackTree()
 		{
-			this->clear();
-			this->delete_node(this->_nil);
+			this->clear_from_node(this->_root);
 		}
 		// ==================== (=) Operator ====================
-		RedBlackTree<T, Compare, Allocator>& operator=(const RedBlackTree<T, Compare, Allocator>& rbt)
+		RedBlackTree<T, Compare, Allocator, KeyOfValue>& operator=(const RedBlackTree<T, Compare, Allocator, KeyOfValue>& rbt)
 		{
 			if (this != &rbt)
 			{
 				this->clear();
 				this->_comp = rbt._comp;
-				this->_alloc = rbt._alloc;
-				this->_node_alloc = rbt._node_alloc;
-				this->_root = NULL;
-				this->new_nil();
-				for (const_iterator it = rbt.begin(); it != rbt.end(); ++it)
-					this->insert(*it);
-				this->move_nil();
+				this->_alloc = rbt._alloc; // _node_alloc stays: it holds this tree's nodes (and pool if any)
+				this->copy_structure(rbt);
 			}
 			return (*this);
 		}
 		// ==================== Accessors ====================
 		size_t max_size() const { return _node_alloc.max_size(); }
-		const rb_node* getRoot() const { return this->_root; }
-		const rb_node* getNil() const { return this->_nil; }
-		size_t size() const	{ return this->size_from_node(this->_root); }
-		allocator_type get_allocator() const { return allocator_type(); }
-		rb_node* first() const
-		{
-			rb_node* tmp = this->_root;
-			while (tmp != NULL && tmp->left != NULL)
-				tmp = tmp->left;
-			return tmp;
-		}
-		rb_node* last() const
-		{
-			rb_node* tmp = this->_root;
-			while (tmp != NULL && tmp->right != NULL)
-				tmp = tmp->right;
-			return tmp;
-		}
-		iterator begin()
-		{
-			rb_node* tmp = this->first();
-			if (tmp != NULL)
-				return iterator(tmp);
-			return iterator(this->end());
-		}
-		const_iterator begin() const
-		{
-			rb_node* tmp = this->first();
-			if (tmp != NULL)
-				return const_iterator(tmp);
-			return const_iterator(this->end());
-		}
+		const rb_links* getRoot() const { return this->_root; }
+		const rb_links* getNil() const { return this->_nil; }
+		size_t size() const	{ return this->_size; }
+		bool empty() const { return this->_size == 0; }
+		allocator_type get_allocator() const { return this->_alloc; }
+		// cached in NIL -> O(1), NULL when the tree is empty
+		rb_links* first() const { return this->_size != 0 ? this->_nil->left : NULL; }
+		rb_links* last() const { return this->_size != 0 ? this->_nil->right : NULL; }
+		iterator begin() { return iterator(this->_nil->left); }
+		const_iterator begin() const { return const_iterator(this->_nil->left); }
 		iterator end() { return iterator(this->_nil); }
 		const_iterator end() const { return const_iterator(this->_nil); }
 		reverse_iterator rbegin() { return reverse_iterator(this->end()); }
@@ -451,162 +758,445 @@ class RedBlackTree
 				1. more complex
 				2. no need to maintain a stack (speed go brrrr)
 		*/
-		template <class Node>
-		static rb_node* successor_in_order(Node* current)
+		static rb_links* successor_in_order(rb_links* current)
 		{
-			if (current == NULL)
-				return (NULL);
+			if (current == NULL || current->get_color() == NIL) // end() stays end()
+				return (current);
+			FT_RBT_STAT(stats().iterator_steps++;)
 			if (current->right != NULL) // node has right child -> traverse link to child then go left as far as we can (smallest value in right subtree)
 			{
 				current = current->right;
+				FT_RBT_STAT(stats().iterator_visits++;)
 				while (current->left != NULL)
+				{
 					current = current->left;
+					FT_RBT_STAT(stats().iterator_visits++;)
+				}
 			}
 			else // node is on the furthest right of it's subtree, up until find a left child node, successor is this node's parent
 			{
-				while (current->parent != NULL && current == current->parent->right)
-					current = current->parent;
-				current = current->parent;
+				rb_links* parent = current->get_parent();
+				FT_RBT_STAT(stats().iterator_visits++;)
+				while (current == parent->right)
+				{
+					current = parent;
+					parent = parent->get_parent();
+					FT_RBT_STAT(stats().iterator_visits++;)
+				}
+				// climbing from the last node ends on NIL (as root's parent), NIL->right is the last node: stay on NIL
+				if (current->right != parent)
+					current = parent;
 			}
 			return (current);
 		}
-		template <class Node>
-		static rb_node* predecessor_in_order(Node* current)
+		static rb_links* predecessor_in_order(rb_links* current)
 		{
 			if (current == NULL)
 				return (NULL);
+			FT_RBT_STAT(stats().iterator_steps++;)
+			FT_RBT_STAT(stats().iterator_visits++;)
+			if (current->get_color() == NIL) // --end() is the last node (NIL itself when empty)
+				return (current->right);
 			if (current->left != NULL)
 			{
 				current = current->left;
 				while (current->right != NULL)
+				{
 					current = current->right;
+					FT_RBT_STAT(stats().iterator_visits++;)
+				}
 			}
 			else
 			{
-				while (current->parent != NULL && current == current->parent->left)
-					current = current->parent;
-				current = current->parent;
-			}		
+				rb_links* parent = current->get_parent();
+				while (current == parent->left)
+				{
+					current = parent;
+					parent = parent->get_parent();
+					FT_RBT_STAT(stats().iterator_visits++;)
+				}
+				current = parent;
+			}
 			return (current);
-		}	
-		void swap(RedBlackTree<T, Compare, Allocator>& other)
+		}
+		void swap(RedBlackTree<T, Compare, Allocator, KeyOfValue>& other)
 		{
+			// headers stay in their trees: first / last links are exchanged, then root <-> NIL relinked
 			std::swap(this->_root, other._root);
-			std::swap(this->_nil, other._nil);
+			std::swap(this->_nil->left, other._nil->left);
+			std::swap(this->_nil->right, other._nil->right);
+			std::swap(this->_size, other._size);
+			this->relink_header();
+			other.relink_header();
 			std::swap(this->_comp, other._comp);
 			std::swap(this->_alloc, other._alloc);
 			std::swap(this->_node_alloc, other._node_alloc);
 		}
-		void print() const
+		void print() const { this->print(std::cout); }
+		void print(std::ostream& out) const
 		{
 			if (this->_root == NULL)
-				std::cout << "Empty tree" << std::endl;
+				out << "Empty tree" << std::endl;
 			else
-				this->printBT("", this->_root, false);
-			std::cout << "======================" << std::endl;
+				this->printBT(out, "", this->_root, false);
+			out << "======================" << std::endl;
 		}
-		rb_node* find(const value_type& val) const
+		// ==================== Statistics ====================
+#ifdef FT_RBT_STATS
+		// Counters of every tree of this type since the start (or the last stats().reset())
+		static ft::rbt_stats& stats()
 		{
-			if (this->equal(val, this->_root->data) || this->_root == NULL)
-				return this->_root;
-			rb_node* tmp = this->_root;
+			static ft::rbt_stats counters;
+			return counters;
+		}
+#endif
+		// O(n) walk: height, black height and average depth of the nodes
+		ft::rbt_shape shape() const
+		{
+			ft::rbt_shape result;
+			result.size = this->_size;
+			result.height = 0;
+			result.black_height = 0;
+			size_t depth_sum = 0;
+			this->measure(this->_root, 0, result.height, depth_sum);
+			for (const rb_links* node = this->_root; node != NULL; node = node->left)
+				result.black_height += (node->get_color() == BLACK);
+			result.average_depth = this->_size ? static_cast<double>(depth_sum) / this->_size : 0;
+			return result;
+		}
+		/*
+			Debug check of every invariant, O(n): true if the tree is sound, false + reason on out otherwise
+			- BST order (strictly increasing keys), parent <-> child links, colors
+			- black root, no red node with a red child, same black height on every path
+			- NIL header: root <-> NIL links, NIL->left / NIL->right = first / last node, element count
+		*/
+		bool verify(std::ostream& out = std::cerr) const
+		{
+			if (this->_nil == NULL || this->_nil->get_color() != NIL)
+				return this->violation(out, "NIL header missing or recolored", 0);
+			if (this->_nil->get_parent() != this->_root)
+				return this->violation(out, "NIL doesn't point to the root", 0);
+			if (this->_root == NULL)
+			{
+				if (this->_nil->left != this->_nil || this->_nil->right != this->_nil || this->_size != 0)
+					return this->violation(out, "empty tree with NIL links or a size", 0);
+				return true;
+			}
+			if (this->_root->get_color() != BLACK)
+				return this->violation(out, "red root", 0);
+			size_t count = 0;
+			if (this->verify_subtree(this->_root, this->_nil, NULL, NULL, count, out) < 0)
+				return false;
+			if (this->_nil->left != leftmost(this->_root) || this->_nil->right != rightmost(this->_root))
+				return this->violation(out, "NIL doesn't point to the first / last node", 0);
+			if (count != this->_size)
+				return this->violation(out, "size doesn't match the node count", count);
+			return true;
+		}
+		// Shape + counters (stats builds) + the nodes themselves if asked
+		void dump(std::ostream& out, bool nodes = false) const
+		{
+			ft::rbt_shape s = this->shape();
+			out << "size: " << s.size << " | height: " << s.height << " | black height: " << s.black_height
+				<< " | average depth: " << s.average_depth << std::endl;
+#ifdef FT_RBT_STATS
+			stats().dump(out);
+#endif
+			if (nodes)
+				this->print(out);
+		}
+		/*
+			Searches take the key itself (K = key_type, or anything a transparent Compare accepts):
+			nodes are compared through KeyOfValue, no value_type is ever built for a lookup
+		*/
+		template <class K>
+		rb_links* find(const K& k) const
+		{
+			FT_RBT_STAT(ft::rbt_operation_scope scope(stats(), stats().lookups);)
+			rb_links* tmp = this->_root;
 			while (tmp != NULL)
 			{
-				if (this->equal(val, tmp->data))
-					return tmp;
-				else if (this->inferior(val, tmp->data))
+				if (this->_comp(k, key(value(tmp))))
 					tmp = tmp->left;
-				else
+				else if (this->_comp(key(value(tmp)), k))
 					tmp = tmp->right;
+				else
+					return tmp;
 			}
-			if (tmp == this->_nil)
-				return NULL;
-			return tmp;
+			return NULL;
 		}
-		bool insert(const value_type& val)
+		/*
+			Bound searches: single descent from the root, O(log n)
+			- candidate is the last node where we went left, NIL (end) if none
+		*/
+		template <class K>
+		rb_links* lower_bound(const K& k) const
 		{
-			rb_node* Z = this->create_node(val);
-			this->hide_nil();
-			if (this->_root == NULL) // empty tree
+			FT_RBT_STAT(ft::rbt_operation_scope scope(stats(), stats().lookups);)
+			rb_links* tmp = this->_root;
+			rb_links* candidate = this->_nil;
+			while (tmp != NULL)
 			{
-				Z->color = BLACK;
-				this->_root = Z;
-				this->move_nil();
-				return true;
+				if (!this->_comp(key(value(tmp)), k))
+				{
+					candidate = tmp;
+					tmp = tmp->left;
+				}
+				else
+					tmp = tmp->right;
 			}
-			rb_node* tmp = this->_root;
-			rb_node* parent = NULL;
+			return candidate;
+		}
+		template <class K>
+		rb_links* upper_bound(const K& k) const
+		{
+			FT_RBT_STAT(ft::rbt_operation_scope scope(stats(), stats().lookups);)
+			rb_links* tmp = this->_root;
+			rb_links* candidate = this->_nil;
 			while (tmp != NULL)
 			{
-				parent = tmp;
-				if (this->equal(Z->data, tmp->data))
-				{ // (map has unique keys -> no duplicates)
-					this->move_nil();
-					return false;
-				}
-				else if (this->inferior(Z->data, tmp->data))
+				if (this->_comp(k, key(value(tmp))))
+				{
+					candidate = tmp;
 					tmp = tmp->left;
+				}
 				else
 					tmp = tmp->right;
 			}
-			// relation kid -> parent
-			Z->parent = parent;
-			// relation parent -> kid
-			if (this->inferior(Z->data, parent->data))
-				parent->left = Z;
-			else
-				parent->right = Z;
-			this->insertion_tree_fix(Z);
-			this->move_nil();
-			return true;
+			return candidate;
 		}
-		void remove(rb_node* node)
+		// Both bounds in one descent: split only once a node equal to key is found
+		template <class K>
+		ft::pair<rb_links*, rb_links*> equal_range(const K& k) const
 		{
-			if (node != NULL)
+			FT_RBT_STAT(ft::rbt_operation_scope scope(stats(), stats().lookups);)
+			rb_links* tmp = this->_root;
+			rb_links* upper = this->_nil;
+			while (tmp != NULL)
 			{
-				this->hide_nil();
-				int color = node->color;
-				rb_node* tmp = NULL;
-				if (node->left == NULL && node->right == NULL) // max 1 child
-					this->switch_node(node, NULL);
-				else if (node->right == NULL) // only left child
+				if (this->_comp(key(value(tmp)), k))
+					tmp = tmp->right;
+				else if (this->_comp(k, key(value(tmp))))
 				{
-					tmp = node->left;
-					this->switch_node(node, node->left);
+					upper = tmp;
+					tmp = tmp->left;
 				}
-				else if (node->left == NULL) // only right child
+				else // equal: lower bound is in the left subtree, upper bound in the right one
+				{
+					rb_links* lower = tmp;
+					rb_links* left = tmp->left;
+					rb_links* right = tmp->right;
+					while (left != NULL)
+					{
+						if (!this->_comp(key(value(left)), k))
+						{
+							lower = left;
+							left = left->left;
+						}
+						else
+							left = left->right;
+					}
+					while (right != NULL)
+					{
+						if (this->_comp(k, key(value(right))))
+						{
+							upper = right;
+							right = right->left;
+						}
+						else
+							right = right->right;
+					}
+					return ft::make_pair(lower, upper);
+				}
+			}
+			return ft::make_pair(upper, upper);
+		}
+		/*
+			Unique insertion in one descent:
+			- key already there -> returns (existing node, false), nothing is allocated
+			- otherwise the node is only created once its slot is known -> (new node, true)
+		*/
+		ft::pair<rb_links*, bool> insert_unique(const value_type& val)
+		{
+			FT_RBT_STAT(ft::rbt_operation_scope scope(stats(), stats().inserts);)
+			rb_links* parent = NULL;
+			bool left = false;
+			rb_links* found = this->find_insert_position(key(val), parent, left);
+			if (found != NULL) // (map has unique keys -> no duplicates)
+				return ft::make_pair(found, false);
+			rb_node* Z = this->create_node(val);
+			this->link_node(Z, parent, left);
+			return ft::make_pair(Z, true);
+		}
+		/*
+			Hinted unique insertion (same contract as libstdc++):
+			- val belongs right before or right after hint -> linked there, no descent from the root
+			- otherwise falls back to a normal descent
+			Feeding sorted input with hint = end() (or the last inserted node) is amortized O(1) search
+		*/
+		ft::pair<rb_links*, bool> insert_unique(rb_links* hint, const value_type& val)
+		{
+			FT_RBT_STAT(ft::rbt_operation_scope scope(stats(), stats().inserts);)
+			rb_links* parent = NULL;
+			bool left = false;
+			rb_links* found = this->find_hint_position(hint, val, parent, left);
+			if (found != NULL)
+				return ft::make_pair(found, false);
+			rb_node* Z = this->create_node(val);
+			this->link_node(Z, parent, left);
+			return ft::make_pair(Z, true);
+		}
+		bool insert(const value_type& val) { return this->insert_unique(val).second; }
+		/*
+			Emplace (see EmplaceArgs.hpp): the value is built right in its node, never copied
+			- key known up front (try_emplace) -> nothing is built when the key is already there
+			- key inside the arguments -> node built first, given back if the key is already there
+		*/
+		template <class Args>
+		ft::pair<rb_links*, bool> emplace_unique_key(const key_type& k, const Args& args)
+		{
+			FT_RBT_STAT(ft::rbt_operation_scope scope(stats(), stats().inserts);)
+			rb_links* parent = NULL;
+			bool left = false;
+			rb_links* found = this->find_insert_position(k, parent, left);
+			if (found != NULL)
+				return ft::make_pair(found, false);
+			rb_node* Z = this->create_node_from(args);
+			this->link_node(Z, parent, left);
+			return ft::make_pair(Z, true);
+		}
+		template <class Args>
+		ft::pair<rb_links*, bool> emplace_unique(const Args& args)
+		{
+			FT_RBT_STAT(ft::rbt_operation_scope scope(stats(), stats().inserts);)
+			rb_node* Z = this->create_node_from(args);
+			rb_links* parent = NULL;
+			bool left = false;
+			rb_links* found = this->find_insert_position(key(Z->data), parent, left);
+			if (found != NULL)
+			{
+				this->delete_node(Z);
+				return ft::make_pair(found, false);
+			}
+			this->link_node(Z, parent, left);
+			return ft::make_pair(Z, true);
+		}
+		/*
+			Range insertion:
+			- non-empty tree -> one hinted insertion per element (hint = end, cheap for appended sorted data)
+			- empty tree -> nodes are chained while the input stays sorted && unique, then the whole
+			  chain is turned into a balanced tree in O(n) (no comparisons against the tree, no rotations)
+			- first out of order element -> chain built as is, the rest falls back to hinted insertions
+		*/
+		template <class InputIterator>
+		void insert_range(InputIterator first, InputIterator last)
+		{
+			if (this->_size == 0)
+			{
+				rb_links* head = NULL; // sorted run, chained by right links, not in the tree yet
+				rb_links* tail = NULL;
+				rb_links* node = NULL; // created, neither chained nor linked yet
+				size_t n = 0;
+				try
+				{
+					for (; first != last; ++first)
+					{
+						node = this->create_node(*first);
+						if (tail != NULL && !this->inferior(value(tail), value(node))) // not sorted || not unique
+						{
+							this->build_sorted(head, n);
+							head = NULL;
+							rb_links* parent = NULL;
+							bool left = false;
+							if (this->find_insert_position(key(value(node)), parent, left) != NULL)
+								this->delete_node(node);
+							else
+								this->link_node(node, parent, left);
+							node = NULL;
+							++first;
+							break;
+						}
+						if (head == NULL)
+							head = node;
+						else
+							tail->right = node;
+						tail = node;
+						node = NULL;
+						n++;
+					}
+					if (head != NULL)
+						this->build_sorted(head, n);
+				}
+				catch (...)
+				{
+					// basic guarantee like one insert_unique per element: nothing leaks, the tree stays valid
+					this->delete_node(node);
+					this->delete_chain(head);
+					throw;
+				}
+			}
+			for (; first != last; ++first)
+				this->insert_unique(this->_nil, *first);
+		}
+		void remove(rb_links* node)
+		{
+			if (node != NULL && node != this->_nil)
+			{
+				// NIL's first/last links move to the neighbour of node
+				if (node == this->_nil->left)
+					this->_nil->left = (this->_size == 1) ? this->_nil : successor_in_order(node);
+				if (node == this->_nil->right)
+					this->_nil->right = (this->_size == 1) ? this->_nil : predecessor_in_order(node);
+				int color = node->get_color();
+				rb_links* tmp = NULL; // node taking the removed black spot (can be NULL)
+				rb_links* tmp_parent = NULL;
+				if (node->left == NULL) // only right child (or none)
 				{
 					tmp = node->right;
+					tmp_parent = node->get_parent();
 					this->switch_node(node, node->right);
 				}
+				else if (node->right == NULL) // only left child
+				{
+					tmp = node->left;
+					tmp_parent = node->get_parent();
+					this->switch_node(node, node->left);
+				}
 				else // 2 children
 				{
-					rb_node* successor = this->successor_in_order(node); // successor will replace node
-					color = successor->color;
+					rb_links* successor = leftmost(node->right); // successor will replace node
+					color = successor->get_color();
 					tmp = successor->right;
-					if (successor->parent != node)
+					if (successor->get_parent() != node)
 					{
+						tmp_parent = successor->get_parent();
 						this->switch_node(successor, successor->right);
 						successor->right = node->right;
-						successor->right->parent = successor;
+						successor->right->set_parent(successor);
 					}
+					else
+						tmp_parent = successor;
 					this->switch_node(node, successor);
 					successor->left = node->left;
-					successor->left->parent = successor;
-					successor->color = node->color;
+					successor->left->set_parent(successor);
+					successor->set_color(node->get_color());
 				}
 				this->delete_node(node);
+				this->_size--;
 				if (color == BLACK)
-					this->deletion_tree_fix(tmp);
-				this->move_nil();
+					this->deletion_tree_fix(tmp, tmp_parent);
 			}
 		}
-		void remove(const T& val) { this->remove(this->find(val)); }
+		void remove(const T& val) { this->remove(this->find(key(val))); }
+		// Frees the real nodes only (the NIL header is a member, never allocated), then resets the header leftmost / rightmost / root links
 		void clear()
 		{
+			if (this->_size == 0)
+				return;
 			this->clear_from_node(this->_root);
-			this->_nil->parent = NULL;
 			this->_root = NULL;
+			this->_size = 0;
+			this->reset_nil();
 		}
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef RELOCATION_HPP
+#define RELOCATION_HPP
+
+#pragma once
+#include "IsTriviallyCopyable.hpp"
+#include <string>
+
+/* Relocation = moving elements to a new buffer (vector growth), the old slots are destroyed right after
+	- memcpy -> trivially copyable T, bytes are copied
+	- swap -> T opted in with is_swap_relocatable: empty T built in place, then swapped with the old one
+	  (the heap buffer changes owner, the empty husk left behind is destroyed for free)
+	- move -> C++11 and later: move constructor (falls back to copy for types without one)
+	- copy -> C++98 default: copy constructor + destructor
+*/
+namespace ft
+{
+	struct memcpy_relocation_tag {};
+	struct swap_relocation_tag {};
+	struct move_relocation_tag {};
+	struct copy_relocation_tag {};
+
+	// Opt-in: default constructor doesn't allocate && swap is O(1) && no throw (ex: std::string, ft::vector)
+	template <class T>
+	struct is_swap_relocatable : public false_type {};
+	template <class CharT, class Traits, class Alloc>
+	struct is_swap_relocatable<std::basic_string<CharT, Traits, Alloc> > : public true_type {};
+
+	template <class T, bool Trivial = is_trivially_copyable<T>::value, bool Swap = is_swap_relocatable<T>::value>
+	struct relocation_category
+	{
+#if __cplusplus >= 201103L
+		typedef move_relocation_tag type;
+#else
+		typedef copy_relocation_tag type;
+#endif
+	};
+	template <class T, bool Swap>
+	struct relocation_category<T, true, Swap> { typedef memcpy_relocation_tag type; };
+	template <class T>
+	struct relocation_category<T, false, true> { typedef swap_relocation_tag type; };
+}
+
+#endif
@@ -16,6 +16,9 @@ namespace ft
 		private:
 			Iterator _it;
 		public:
+			typedef Iterator iterator_type;
+			typedef typename ft::iterator_traits<Iterator>::iterator_category iterator_category;
+			typedef typename ft::iterator_traits<Iterator>::value_type value_type;
 			typedef typename ft::iterator_traits<Iterator>::difference_type difference_type;
 			typedef typename ft::iterator_traits<Iterator>::pointer pointer;
 			typedef typename ft::iterator_traits<Iterator>::reference reference;
@@ -0,0 +1,273 @@
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#pragma once
+#include "Vector.hpp"
+#include <memory>
+
+/* small_vector specificities:
+	- ft::vector (same iterators, same modifiers, same growth policies) with room for N elements inside the object
+	- up to N elements -> no heap allocation at all, beyond N -> spills to the heap like a vector
+	  (auto-trimming growth policies never trim below N: inline stays inline, trimmed heap buffers come back inline)
+	- the inline buffer is handed to the vector through inline_allocator: the vector code doesn't know about it
+	- swapping two inline buffers copies elements (swapping pointers only works for heap buffers)
+	- not usable as an ft::vector (private base): the inline buffer must never be shared with another object
+*/
+namespace ft
+{
+	// Inline buffer, in a base class so it exists before the vector base receives its allocator
+	template <class T, size_t N>
+	struct small_vector_storage
+	{
+		union
+		{
+			char bytes[N * sizeof(T)];
+			long double align_long_double;
+			long long align_long_long;
+			void* align_pointer;
+		} buffer;
+		bool in_use;
+		small_vector_storage() : in_use(false) {}
+		// never shared: each small_vector has its own buffer
+		small_vector_storage(const small_vector_storage&) : in_use(false) {}
+		small_vector_storage& operator=(const small_vector_storage&) { return *this; }
+		T* inline_data() { return reinterpret_cast<T*>(this->buffer.bytes); }
+	};
+
+	// Hands out the inline buffer for any request that fits while it's free, Alloc (heap) otherwise
+	template <class T, size_t N, class Alloc>
+	class inline_allocator
+	{
+		public:
+			typedef typename Alloc::value_type value_type;
+			typedef typename Alloc::pointer pointer;
+			typedef typename Alloc::const_pointer const_pointer;
+			typedef typename Alloc::reference reference;
+			typedef typename Alloc::const_reference const_reference;
+			typedef typename Alloc::size_type size_type;
+			typedef typename Alloc::difference_type difference_type;
+			template <class U>
+			struct rebind
+			{
+				typedef typename Alloc::template rebind<U>::other other;
+			};
+		private:
+			small_vector_storage<T, N>* _storage;
+			Alloc _heap;
+		public:
+			inline_allocator() : _storage(NULL), _heap() {}
+			inline_allocator(small_vector_storage<T, N>* storage, const Alloc& heap) : _storage(storage), _heap(heap) {}
+			inline_allocator(const inline_allocator& other) : _storage(other._storage), _heap(other._heap) {}
+			// a vector assigning / swapping allocators keeps its own buffer
+			inline_allocator& operator=(const inline_allocator&) { return *this; }
+			pointer allocate(size_type n, const void* hint = 0)
+			{
+				if (this->_storage != NULL && n <= N && !this->_storage->in_use)
+				{
+					this->_storage->in_use = true;
+					return this->_storage->inline_data();
+				}
+				return this->_heap.allocate(n, hint);
+			}
+			void deallocate(pointer p, size_type n)
+			{
+				if (this->_storage != NULL && p == this->_storage->inline_data())
+					this->_storage->in_use = false;
+				else
+					this->_heap.deallocate(p, n);
+			}
+			void construct(pointer p, const_reference val) { this->_heap.construct(p, val); }
+			void destroy(pointer p) { this->_heap.destroy(p); }
+			size_type max_size() const { return this->_heap.max_size(); }
+			pointer address(reference x) const { return &x; }
+			const_pointer address(const_reference x) const { return &x; }
+			Alloc heap_allocator() const { return this->_heap; }
+			bool operator==(const inline_allocator& other) const { return this->_storage == other._storage; }
+			bool operator!=(const inline_allocator& other) const { return this->_storage != other._storage; }
+	};
+
+	// Growth policy of the vector base: Growth, but a trim never goes below N
+	// -> capacity is N while inline (trimming it would need a second buffer = the heap),
+	// a heap buffer trimmed to N or less lands back in the inline buffer
+	template <class Growth, size_t N>
+	struct inline_growth
+	{
+		static size_t next_capacity(size_t capacity, size_t required, size_t elem_size) { return Growth::next_capacity(capacity, required, elem_size); }
+		static size_t trim_capacity(size_t capacity, size_t size, size_t elem_size)
+		{
+			if (capacity <= N)
+				return capacity;
+			size_t next = Growth::trim_capacity(capacity, size, elem_size);
+			return next < N ? N : next;
+		}
+	};
+
+	/*
+		The vector base is private: its allocator points at this object's inline buffer, so anything that would copy it
+		out (slicing copy, vector::swap, a vector built from get_allocator()) would share the buffer between two objects.
+		Only the members that keep the allocator inside are re-exported, swap / copies / range inserts are redone here.
+	*/
+	template <class T, size_t N, class Alloc = std::allocator<T>, class Growth = ft::doubling_growth>
+	class small_vector : private small_vector_storage<T, N>, private ft::vector<T, ft::inline_allocator<T, N, Alloc>, ft::inline_growth<Growth, N> >
+	{
+		private:
+			typedef small_vector_storage<T, N> storage_type;
+			typedef ft::vector<T, ft::inline_allocator<T, N, Alloc>, ft::inline_growth<Growth, N> > vector_type;
+			typedef typename vector_type::allocator_type inline_allocator_type;
+		public:
+			typedef typename vector_type::value_type value_type;
+			typedef Alloc allocator_type;
+			typedef typename vector_type::reference reference;
+			typedef typename vector_type::const_reference const_reference;
+			typedef typename vector_type::pointer pointer;
+			typedef typename vector_type::const_pointer const_pointer;
+			typedef typename vector_type::size_type size_type;
+			typedef typename vector_type::difference_type difference_type;
+			typedef typename vector_type::iterator iterator;
+			typedef typename vector_type::const_iterator const_iterator;
+			typedef typename vector_type::reverse_iterator reverse_iterator;
+			typedef typename vector_type::const_reverse_iterator const_reverse_iterator;
+			static const size_t inline_capacity = N;
+		// ====================  Constructors  ====================
+			// Every constructor starts on the inline buffer (capacity N)
+			explicit small_vector(const Alloc &alloc = Alloc()) : vector_type(inline_allocator_type(this, alloc)) { this->reserve(N); };
+			explicit small_vector(size_t n, const value_type &val = value_type(), const Alloc &alloc = Alloc()) : vector_type(inline_allocator_type(this, alloc))
+			{
+				this->reserve(N);
+				this->assign(n, val);
+			};
+			template <class InputIterator>
+			small_vector(InputIterator first, InputIterator last, const Alloc &alloc = Alloc()) : vector_type(inline_allocator_type(this, alloc))
+			{
+				this->reserve(N);
+				this->assign(first, last);
+			};
+			small_vector(const small_vector &x) : storage_type(), vector_type(inline_allocator_type(this, x.get_allocator()))
+			{
+				this->reserve(N);
+				this->assign(x.begin(), x.end());
+			};
+		// ==================== (=) Operator ====================
+			small_vector &operator=(const small_vector &x)
+			{
+				vector_type::operator=(x);
+				return *this;
+			};
+		// ====================  Vector members  ====================
+			using vector_type::size;
+			using vector_type::max_size;
+			using vector_type::capacity;
+			using vector_type::bytes_reserved;
+			using vector_type::bytes_used;
+			using vector_type::empty;
+			using vector_type::begin;
+			using vector_type::end;
+			using vector_type::rbegin;
+			using vector_type::rend;
+			using vector_type::reserve;
+			using vector_type::resize;
+			using vector_type::resize_uninitialized;
+			using vector_type::operator[];
+			using vector_type::at;
+			using vector_type::front;
+			using vector_type::back;
+			using vector_type::data;
+			using vector_type::assign;
+			using vector_type::push_back;
+			using vector_type::emplace_back;
+			using vector_type::emplace;
+			using vector_type::pop_back;
+			using vector_type::clear;
+			using vector_type::insert;
+			using vector_type::erase;
+			// The heap allocator (the inline one never leaves the object)
+			allocator_type get_allocator() const { return vector_type::get_allocator().heap_allocator(); };
+			// Insert (range): an input range in the middle is buffered on the heap first
+			// (the vector would buffer it in a vector sharing this object's allocator)
+			template <class InputIterator>
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value, void>::type insert(iterator position, InputIterator first, InputIterator last)
+			{
+				this->insert_range(position, first, last, typename ft::iterator_tag<InputIterator>::type());
+			};
+		// ====================  Inline buffer  ====================
+			bool is_inline() const { return this->data() == const_cast<small_vector *>(this)->inline_data(); };
+			// Heap buffer small enough -> back to the inline buffer, inline buffer -> nothing to release
+			void shrink_to_fit()
+			{
+				if (this->is_inline())
+					return;
+				if (this->size() > N)
+				{
+					vector_type::shrink_to_fit();
+					return;
+				}
+				ft::vector<T, Alloc> elements(this->begin(), this->end());
+				this->clear();
+				vector_type::shrink_to_fit();
+				this->reserve(N);
+				this->assign(elements.begin(), elements.end());
+			};
+			// Two heap buffers -> pointer swap, otherwise elements are copied
+			void swap(small_vector &x)
+			{
+				if (!this->is_inline() && !x.is_inline())
+				{
+					vector_type::swap(x);
+					return;
+				}
+				small_vector tmp(*this);
+				*this = x;
+				x = tmp;
+			};
+		private:
+			template <class InputIterator>
+			void insert_range(iterator position, InputIterator first, InputIterator last, ft::input_iterator_tag)
+			{
+				if (position == this->end())
+				{
+					vector_type::insert(position, first, last); // appended one by one, no buffer
+					return;
+				}
+				ft::vector<T, Alloc> batch(first, last, this->get_allocator());
+				vector_type::insert(position, batch.begin(), batch.end());
+			};
+			template <class ForwardIterator>
+			void insert_range(iterator position, ForwardIterator first, ForwardIterator last, ft::forward_iterator_tag) { vector_type::insert(position, first, last); };
+	};
+	// ==================== Relational operators ====================
+	// The vector base is private: same comparisons as ft::vector's, on the elements
+	template <class T, size_t N, class Alloc, class Growth>
+	bool operator==(const small_vector<T, N, Alloc, Growth> &lhs, const small_vector<T, N, Alloc, Growth> &rhs)
+	{
+		return lhs.size() == rhs.size() && ft::range_equal(lhs.data(), rhs.data(), lhs.size());
+	};
+	template <class T, size_t N, class Alloc, class Growth>
+	bool operator!=(const small_vector<T, N, Alloc, Growth> &lhs, const small_vector<T, N, Alloc, Growth> &rhs)
+	{
+		return !(lhs == rhs);
+	};
+	template <class T, size_t N, class Alloc, class Growth>
+	bool operator<(const small_vector<T, N, Alloc, Growth> &lhs, const small_vector<T, N, Alloc, Growth> &rhs)
+	{
+		return ft::range_compare(lhs.data(), lhs.size(), rhs.data(), rhs.size()) < 0;
+	};
+	template <class T, size_t N, class Alloc, class Growth>
+	bool operator<=(const small_vector<T, N, Alloc, Growth> &lhs, const small_vector<T, N, Alloc, Growth> &rhs)
+	{
+		return ft::range_compare(lhs.data(), lhs.size(), rhs.data(), rhs.size()) <= 0;
+	};
+	template <class T, size_t N, class Alloc, class Growth>
+	bool operator>(const small_vector<T, N, Alloc, Growth> &lhs, const small_vector<T, N, Alloc, Growth> &rhs)
+	{
+		return ft::range_compare(lhs.data(), lhs.size(), rhs.data(), rhs.size()) > 0;
+	};
+	template <class T, size_t N, class Alloc, class Growth>
+	bool operator>=(const small_vector<T, N, Alloc, Growth> &lhs, const small_vector<T, N, Alloc, Growth> &rhs)
+	{
+		return ft::range_compare(lhs.data(), lhs.size(), rhs.data(), rhs.size()) >= 0;
+	};
+	template <class T, size_t N, class Alloc, class Growth>
+	void swap(small_vector<T, N, Alloc, Growth> &x, small_vector<T, N, Alloc, Growth> &y) { x.swap(y); };
+}
+
+#endif
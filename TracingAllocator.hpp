@@ -0,0 +1,177 @@
+#ifndef TRACING_ALLOCATOR_HPP
+#define TRACING_ALLOCATOR_HPP
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <ostream>
+
+/* tracing_allocator specificities:
+	- wraps another allocator (std::allocator by default) and records every call in an allocation_stats
+	- stats = calls, bytes, live / peak bytes, histogram of request sizes, optional trace callback
+	- copies and rebinds record into the same stats: a map's nodes land in the map's stats
+	- one stats per container -> give each one its own (tracing_allocator<T>(&stats)),
+	  default constructed allocators share a process wide one (global_allocation_stats())
+	- only counter updates on the hot path (no locks: one stats per thread)
+*/
+namespace ft
+{
+	struct allocation_stats
+	{
+		static const size_t buckets = 48;
+		typedef void (*trace_function)(const char* event, const void* p, size_t bytes, void* context);
+		size_t allocations;
+		size_t deallocations;
+		size_t constructs;
+		size_t destroys;
+		size_t bytes_allocated;
+		size_t bytes_deallocated;
+		size_t live_bytes;
+		size_t peak_bytes;
+		size_t histogram[buckets]; // histogram[i] = requests of [2^i, 2^(i + 1)) bytes (0 bytes counted in 0)
+		trace_function trace; // called on every allocate / deallocate when set
+		void* trace_context;
+
+		allocation_stats() : trace(NULL), trace_context(NULL) { this->reset(); }
+		void reset()
+		{
+			this->allocations = 0;
+			this->deallocations = 0;
+			this->constructs = 0;
+			this->destroys = 0;
+			this->bytes_allocated = 0;
+			this->bytes_deallocated = 0;
+			this->live_bytes = 0;
+			this->peak_bytes = 0;
+			for (size_t i = 0; i < buckets; i++)
+				this->histogram[i] = 0;
+		}
+		static size_t bucket(size_t bytes)
+		{
+			size_t i = 0;
+#if defined(__GNUC__)
+			if (bytes > 1)
+				i = sizeof(unsigned long) * 8 - 1 - __builtin_clzl(bytes);
+#else
+			while (bytes > 1)
+			{
+				bytes >>= 1;
+				i++;
+			}
+#endif
+			return (i < buckets) ? i : buckets - 1;
+		}
+		void record_allocate(const void* p, size_t bytes)
+		{
+			this->allocations++;
+			this->bytes_allocated += bytes;
+			this->live_bytes += bytes;
+			if (this->live_bytes > this->peak_bytes)
+				this->peak_bytes = this->live_bytes;
+			this->histogram[bucket(bytes)]++;
+			if (this->trace != NULL)
+				this->trace("allocate", p, bytes, this->trace_context);
+		}
+		void record_deallocate(const void* p, size_t bytes)
+		{
+			this->deallocations++;
+			this->bytes_deallocated += bytes;
+			this->live_bytes -= bytes;
+			if (this->trace != NULL)
+				this->trace("deallocate", p, bytes, this->trace_context);
+		}
+		// Everything allocated was given back (constructs / destroys don't have to match: containers may
+		// build elements with placement new or memcpy, ex: ft::vector's emplace and trivially copyable T)
+		bool balanced() const { return this->allocations == this->deallocations && this->live_bytes == 0; }
+		void dump(std::ostream& out) const
+		{
+			out << "allocations: " << this->allocations << " | deallocations: " << this->deallocations
+				<< " | constructs: " << this->constructs << " | destroys: " << this->destroys << std::endl;
+			out << "bytes allocated: " << this->bytes_allocated << " | live: " << this->live_bytes << " | peak: " << this->peak_bytes << std::endl;
+			for (size_t i = 0; i < buckets; i++)
+				if (this->histogram[i] != 0)
+					out << "  [" << (static_cast<size_t>(1) << i) << ", " << (static_cast<size_t>(1) << i) * 2 << ") bytes: " << this->histogram[i] << std::endl;
+		}
+	};
+
+	inline allocation_stats& global_allocation_stats()
+	{
+		static allocation_stats stats;
+		return stats;
+	}
+
+	template <class T, class Alloc = std::allocator<T> >
+	class tracing_allocator
+	{
+		public:
+			typedef typename Alloc::value_type value_type;
+			typedef typename Alloc::pointer pointer;
+			typedef typename Alloc::const_pointer const_pointer;
+			typedef typename Alloc::reference reference;
+			typedef typename Alloc::const_reference const_reference;
+			typedef typename Alloc::size_type size_type;
+			typedef typename Alloc::difference_type difference_type;
+			template <class U>
+			struct rebind
+			{
+				typedef tracing_allocator<U, typename Alloc::template rebind<U>::other> other;
+			};
+		private:
+			template <class U, class A>
+			friend class tracing_allocator;
+			allocation_stats* _stats;
+			Alloc _alloc;
+		public:
+		// ==================== Constructors ====================
+			tracing_allocator() : _stats(&global_allocation_stats()), _alloc() {}
+			explicit tracing_allocator(allocation_stats* stats, const Alloc& alloc = Alloc()) : _stats(stats), _alloc(alloc) {}
+			tracing_allocator(const tracing_allocator& other) : _stats(other._stats), _alloc(other._alloc) {}
+			// Rebinding: same stats, wrapped allocator rebound too
+			template <class U, class A>
+			tracing_allocator(const tracing_allocator<U, A>& other) : _stats(other._stats), _alloc(other._alloc) {}
+		// ==================== (=) Operator ====================
+			// same as copying: records into other's stats from now on
+			tracing_allocator& operator=(const tracing_allocator& other)
+			{
+				this->_stats = other._stats;
+				this->_alloc = other._alloc;
+				return *this;
+			}
+		// ==================== Allocation ====================
+			pointer allocate(size_type n, const void* hint = 0)
+			{
+				pointer p = this->_alloc.allocate(n, hint);
+				this->_stats->record_allocate(p, n * sizeof(T));
+				return p;
+			}
+			void deallocate(pointer p, size_type n)
+			{
+				if (p == NULL)
+					return;
+				this->_stats->record_deallocate(p, n * sizeof(T));
+				this->_alloc.deallocate(p, n);
+			}
+			void construct(pointer p, const_reference val)
+			{
+				this->_stats->constructs++;
+				this->_alloc.construct(p, val);
+			}
+			void destroy(pointer p)
+			{
+				this->_stats->destroys++;
+				this->_alloc.destroy(p);
+			}
+			size_type max_size() const { return this->_alloc.max_size(); }
+			pointer address(reference x) const { return &x; }
+			const_pointer address(const_reference x) const { return &x; }
+		// ==================== Statistics ====================
+			allocation_stats& stats() const { return *this->_stats; }
+		// ==================== Comparison ====================
+			template <class U, class A>
+			bool operator==(const tracing_allocator<U, A>& other) const { return this->_stats == other._stats && this->_alloc == other._alloc; }
+			template <class U, class A>
+			bool operator!=(const tracing_allocator<U, A>& other) const { return !(*this == other); }
+	};
+}
+
+#endif
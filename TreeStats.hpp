@@ -0,0 +1,102 @@
+#ifndef TREE_STATS_HPP
+#define TREE_STATS_HPP
+
+#pragma once
+#include <cstddef>
+#include <ostream>
+
+/*
+	RedBlackTree counters, compiled in with -DFT_RBT_STATS only
+	- FT_RBT_STAT(statement) keeps statement in stats builds, expands to nothing otherwise
+	  (Compare isn't wrapped either: a normal build runs the exact same code as before)
+	- counters are per tree type (RedBlackTree::stats()), iterators don't know their tree
+	- the tree shape (height, black height, depth) is computed on demand, stats build or not
+*/
+#ifdef FT_RBT_STATS
+# define FT_RBT_STAT(statement) statement
+#else
+# define FT_RBT_STAT(statement)
+#endif
+
+namespace ft
+{
+	struct rbt_operation_stats
+	{
+		size_t calls;
+		size_t comparisons;
+		double per_call() const { return this->calls ? static_cast<double>(this->comparisons) / this->calls : 0; }
+	};
+
+	struct rbt_stats
+	{
+		size_t comparisons; // every Compare call
+		rbt_operation_stats lookups; // find / lower_bound / upper_bound / equal_range
+		rbt_operation_stats inserts; // unique insertions (hinted or not) and emplaces
+		size_t rotations;
+		size_t recolors; // color changes made by the insertion / deletion fixes
+		size_t iterator_steps; // ++ / -- on an iterator
+		size_t iterator_visits; // nodes walked by those steps
+
+		rbt_stats() { this->reset(); }
+		void reset()
+		{
+			this->comparisons = 0;
+			this->lookups.calls = 0;
+			this->lookups.comparisons = 0;
+			this->inserts.calls = 0;
+			this->inserts.comparisons = 0;
+			this->rotations = 0;
+			this->recolors = 0;
+			this->iterator_steps = 0;
+			this->iterator_visits = 0;
+		}
+		void dump(std::ostream& out) const
+		{
+			out << "comparisons: " << this->comparisons
+				<< " | lookups: " << this->lookups.calls << " (" << this->lookups.per_call() << " comparisons each)"
+				<< " | inserts: " << this->inserts.calls << " (" << this->inserts.per_call() << " comparisons each)" << std::endl;
+			out << "rotations: " << this->rotations << " | recolors: " << this->recolors
+				<< " | iterator steps: " << this->iterator_steps << " (" << (this->iterator_steps ? static_cast<double>(this->iterator_visits) / this->iterator_steps : 0) << " nodes each)" << std::endl;
+		}
+	};
+
+	// Comparisons done between its construction and its destruction are charged to one operation
+	class rbt_operation_scope
+	{
+		private:
+			const rbt_stats& _stats;
+			rbt_operation_stats& _operation;
+			size_t _start;
+		public:
+			rbt_operation_scope(const rbt_stats& stats, rbt_operation_stats& operation) : _stats(stats), _operation(operation), _start(stats.comparisons) {}
+			~rbt_operation_scope()
+			{
+				this->_operation.calls++;
+				this->_operation.comparisons += this->_stats.comparisons - this->_start;
+			}
+	};
+
+	// Compare that counts its calls in Owner::stats() (stats builds only)
+	template <class Compare, class Owner>
+	struct counting_compare
+	{
+		Compare comp;
+		counting_compare(const Compare& c = Compare()) : comp(c) {}
+		template <class A, class B>
+		bool operator()(const A& a, const B& b) const
+		{
+			Owner::stats().comparisons++;
+			return this->comp(a, b);
+		}
+	};
+
+	struct rbt_shape
+	{
+		size_t size;
+		size_t height; // nodes on the longest root to leaf path
+		size_t black_height; // black nodes on any root to leaf path
+		double average_depth; // root = 0
+	};
+}
+
+#endif
@@ -4,22 +4,39 @@
 #pragma once
 #include "VectorIterator.hpp"
 #include "ReverseIterator.hpp"
+#include "IsTriviallyCopyable.hpp"
+#include "Relocation.hpp"
+#include "GrowthPolicy.hpp"
+#include "EmplaceArgs.hpp"
+#include "RangeCompare.hpp"
+#include "CallocAllocator.hpp"
+#include "LatencyProfiler.hpp"
+#include <algorithm>
 #include <memory>
+#include <cstring>
+#include <stdexcept>
 
 /* vector specificities:
 	- Sequence (ordered)
 	- Random access
 	- Allocator-aware
+	- Trivially copyable T (ex: int, plain structs) is copied / shifted with memcpy / memmove
+	- Growth relocates elements (see Relocation.hpp): strings && nested vectors keep their heap buffers
+	- Growth amount is a policy (see GrowthPolicy.hpp), doubling by default, which may also trim the buffer when size drops
+	- Latency sampling of the operations is a policy too (see LatencyProfiler.hpp), off by default
+	- Ranges are dispatched on their iterator category: forward ranges are measured first (one allocation, one pass to copy),
+	  input ranges (ex: istream_iterator) are read exactly once
 */
 namespace ft
 {
-	template <class T, class Alloc = std::allocator<T> >
+	template <class T, class Alloc = std::allocator<T>, class Growth = ft::doubling_growth, class Profiler = ft::no_profiler >
 	class vector
 	{
 
 		public:
 			typedef T value_type;
 			typedef Alloc allocator_type;
+			typedef Profiler profiler_type;
 			typedef T &reference;
 			typedef const T &const_reference;
 			typedef T *pointer;
@@ -37,20 +54,18 @@ namespace ft
 			// Fill
 			explicit vector(size_t n, const value_type &val = value_type(), const allocator_type &alloc = allocator_type()) : _alloc(alloc), _size(n), _capacity(n), _data(_alloc.allocate(n))
 			{
-				for (size_t i = 0; i < n; i++)
-					_alloc.construct(_data + i, val);
+				fill_fresh(_data, n, val);
 			};
 			// Range
 			template <class InputIterator>
 			vector(InputIterator first, InputIterator last, const allocator_type &alloc = allocator_type()) : _alloc(alloc), _size(0), _capacity(0), _data(NULL)
 			{
-				assign(first, last);
+				initialize(first, last, ft::is_integral<InputIterator>());
 			};
 			// Copy
 			vector(const vector &x) : _alloc(x._alloc), _size(x._size), _capacity(x._capacity), _data(_alloc.allocate(x._capacity))
 			{
-				for (size_t i = 0; i < x._size; i++)
-					_alloc.construct(_data + i, x._data[i]);
+				copy_construct(_data, x._data, x._size, _trivial());
 			};
 			// ====================  Destructors  ====================
 			~vector()
@@ -63,6 +78,9 @@ namespace ft
 			size_t size() const { return _size; };
 			size_t max_size() const { return _alloc.max_size(); };
 			size_t capacity() const { return _capacity; };
+			// Memory held vs memory holding elements (the difference is slack)
+			size_t bytes_reserved() const { return _capacity * sizeof(T); };
+			size_t bytes_used() const { return _size * sizeof(T); };
 			bool empty() const { return _size == 0; };
 		// ==================== (=) Operator ====================
 			vector &operator=(const vector &x)
@@ -76,8 +94,7 @@ namespace ft
 					_size = x._size;
 					_capacity = x._capacity;
 					_data = _alloc.allocate(x._capacity);
-					for (size_t i = 0; i < x._size; i++)
-						_alloc.construct(_data + i, x._data[i]);
+					copy_construct(_data, x._data, x._size, _trivial());
 				}
 				return *this;
 			};
@@ -97,34 +114,49 @@ namespace ft
 			// Request a change in capacity
 			void reserve(size_t n)
 			{
+				_profiled profiled(ft::profile_resize);
 				if (n > _capacity)
-				{
-					pointer tmp = _alloc.allocate(n);
-					for (size_t i = 0; i < _size; i++)
-						_alloc.construct(tmp + i, _data[i]);
-					for (size_t i = 0; i < _size; i++)
-						_alloc.destroy(_data + i);
-					_alloc.deallocate(_data, _capacity);
-					_data = tmp;
-					_capacity = n;
-				}
+					reallocate(n);
+			};
+			// Non-binding in the standard, here always honored: capacity becomes size (0 -> buffer released)
+			void shrink_to_fit()
+			{
+				_profiled profiled(ft::profile_resize);
+				if (_capacity > _size)
+					reallocate(_size);
 			};
 			// Resize the container
-			void resize(size_t n, value_type val = value_type())
+			void resize(size_t n, const value_type &val = value_type())
 			{
+				_profiled profiled(ft::profile_resize);
 				if (n > _capacity)
-					reserve(n);
-				if (n > _size)
 				{
-					for (size_t i = _size; i < n; i++)
-						_alloc.construct(_data + i, val);
+					const value_type copy(val); // val may be an element of the old buffer
+					grow(n);
+					construct_fill(_data + _size, n - _size, copy, _trivial());
 				}
+				else if (n > _size)
+					construct_fill(_data + _size, n - _size, val, _trivial());
 				else if (n < _size)
 				{
 					for (size_t i = n; i < _size; i++)
 						_alloc.destroy(_data + i);
 				}
 				_size = n;
+				trim();
+			};
+			// resize() without writing the new elements when T's default constructor does nothing (ex: int, plain structs)
+			// -> their value is whatever the buffer held, to be overwritten by the caller; other T are value initialized
+			void resize_uninitialized(size_t n)
+			{
+				if (n > _size && ft::is_trivially_default_constructible<T>::value)
+				{
+					_profiled profiled(ft::profile_resize);
+					grow(n);
+					_size = n;
+				}
+				else
+					resize(n);
 			};
 		// ====================  Element accerss  ====================
 			// no check if out of range, undefined behavior. (faster)
@@ -149,39 +181,66 @@ namespace ft
 			// Last element
 			reference back() { return _data[_size - 1]; };
 			const_reference back() const { return _data[_size - 1]; };
+			// Underlying buffer (NULL while nothing was allocated)
+			pointer data() { return _data; };
+			const_pointer data() const { return _data; };
 		// ====================  Modifiers  ====================
 			// Assign content (fill)
 			void assign(size_t n, const value_type &val)
 			{
+				_profiled profiled(ft::profile_assign);
+				const value_type copy(val); // val may be an element of the vector
 				clear();
-				for (size_t i = 0; i < n; i++)
-					push_back(val);
+				grow(n);
+				construct_fill(_data, n, copy, _trivial());
+				_size = n;
 			};
 			// Assign content (range)
 			template <class InputIterator>
 			typename ft::enable_if<!ft::is_integral<InputIterator>::value, void>::type assign(InputIterator first, InputIterator last)
 			{
-				clear();
-				for (InputIterator it = first; it != last; it++)
-					push_back(*it);
+				_profiled profiled(ft::profile_assign);
+				assign_range(first, last, typename ft::iterator_tag<InputIterator>::type());
 			};
 			// Add element at end
 			void push_back(const value_type &val)
 			{
-				if (_capacity == 0)
-					reserve(1);
+				_profiled profiled(ft::profile_push_back);
 				if (_size == _capacity)
-					reserve(_capacity * 2);
-				_alloc.construct(_data + _size, val);
+				{
+					const value_type copy(val); // val may be an element of the old buffer
+					grow(_size + 1);
+					_alloc.construct(_data + _size, copy);
+				}
+				else
+					_alloc.construct(_data + _size, val);
 				_size++;
 			};
+			// Construct element at end from its constructor arguments (C++98: up to 3, see EmplaceArgs.hpp)
+			void emplace_back() { emplace_back_args(ft::emplace_args0()); };
+			template <class A1>
+			void emplace_back(const A1 &a1) { emplace_back_args(ft::emplace_args1<A1>(a1)); };
+			template <class A1, class A2>
+			void emplace_back(const A1 &a1, const A2 &a2) { emplace_back_args(ft::emplace_args2<A1, A2>(a1, a2)); };
+			template <class A1, class A2, class A3>
+			void emplace_back(const A1 &a1, const A2 &a2, const A3 &a3) { emplace_back_args(ft::emplace_args3<A1, A2, A3>(a1, a2, a3)); };
+			// Same at position (see emplace_args)
+			iterator emplace(iterator position) { return emplace_args(position - begin(), ft::emplace_args0()); };
+			template <class A1>
+			iterator emplace(iterator position, const A1 &a1) { return emplace_args(position - begin(), ft::emplace_args1<A1>(a1)); };
+			template <class A1, class A2>
+			iterator emplace(iterator position, const A1 &a1, const A2 &a2) { return emplace_args(position - begin(), ft::emplace_args2<A1, A2>(a1, a2)); };
+			template <class A1, class A2, class A3>
+			iterator emplace(iterator position, const A1 &a1, const A2 &a2, const A3 &a3) { return emplace_args(position - begin(), ft::emplace_args3<A1, A2, A3>(a1, a2, a3)); };
 			// Remove last element
 			void pop_back()
 			{
+				_profiled profiled(ft::profile_pop_back);
 				if (_size > 0)
 				{
 					_alloc.destroy(_data + _size - 1);
 					_size--;
+					trim();
 				}
 			};
 			// Remove all
@@ -207,71 +266,52 @@ namespace ft
 				_alloc = x._alloc;
 				x._alloc = tmp3;
 			};
+			/*
+				Insert / erase shifting (same scheme as libstdc++):
+				- only the slots past the old end are raw memory -> constructed once (uninitialized tail)
+				- every other slot already holds a live element -> assigned (copy_backward / copy / fill)
+				- erase assigns the tail down and destroys exactly the n last slots
+				-> one constructor or assignment per moved element, each element destroyed exactly once
+			*/
 			// Insert (1)
 			iterator insert(iterator position, const value_type &val)
 			{
+				_profiled profiled(ft::profile_insert);
 				size_t pos = position - begin();
-				if (_size == 0)
-					reserve(1);
-				if (_size == _capacity)
-					reserve(_capacity * 2);
-				for (size_t i = _size; i > pos; i--)
-					_alloc.construct(_data + i, _data[i - 1]);
-				_alloc.construct(_data + pos, val);
-				_size++;
+				const value_type copy(val); // val may be an element about to move
+				grow(_size + 1);
+				insert_fill(pos, 1, copy);
 				return iterator(_data + pos);
 			};
 			// Insert (fill)
 			void insert(iterator position, size_t n, const value_type &val)
 			{
+				_profiled profiled(ft::profile_insert);
 				size_t pos = position - begin();
-				if (_size + n > _capacity)
-					reserve(_size + n);
-				for (size_t i = _size; i > pos; i--)
-					_alloc.construct(_data + i + n - 1, _data[i - 1]);
-				for (size_t i = pos; i < pos + n; i++)
-					_alloc.construct(_data + i, val);
-				_size += n;
+				const value_type copy(val);
+				grow(_size + n);
+				insert_fill(pos, n, copy);
 			};
 			// Insert (range)
 			template <class InputIterator>
 			typename ft::enable_if<!ft::is_integral<InputIterator>::value, void>::type insert(iterator position, InputIterator first, InputIterator last)
 			{
-				size_t pos = position - begin();
-				size_t n = 0;
-				for (InputIterator it = first; it != last; it++)
-					n++;
-				if (_size + n > _capacity)
-					reserve(_size + n);
-				for (size_t i = _size; i > pos; i--)
-					_alloc.construct(_data + i + n - 1, _data[i - 1]);
-				for (size_t i = pos; i < pos + n; i++)
-				{
-					_alloc.construct(_data + i, *first);
-					first++;
-				}
-				_size += n;
+				_profiled profiled(ft::profile_insert);
+				insert_range(position - begin(), first, last, typename ft::iterator_tag<InputIterator>::type());
 			};
 			// Erase (1)
-			iterator erase(iterator position)
-			{
-				size_t pos = position - begin();
-				_alloc.destroy(_data + pos);
-				for (size_t i = pos; i < _size - 1; i++)
-					_alloc.construct(_data + i, _data[i + 1]);
-				_size--;
-				return iterator(_data + pos);
-			};
+			iterator erase(iterator position) { return erase(position, position + 1); };
 			// Erase (range)
 			iterator erase(iterator first, iterator last)
 			{
+				_profiled profiled(ft::profile_erase);
 				size_t pos = first - begin();
 				size_t n = last - first;
-				for (size_t i = pos; i < pos + n; i++)
+				std::copy(_data + pos + n, _data + _size, _data + pos);
+				for (size_t i = _size - n; i < _size; i++)
 					_alloc.destroy(_data + i);
-				for (size_t i = pos; i < _size - n; i++)
-					_alloc.construct(_data + i, _data[i + n]);
 				_size -= n;
+				trim();
 				return iterator(_data + pos);
 			};
 		private:
@@ -279,103 +319,335 @@ namespace ft
 			size_t _size;
 			size_t _capacity;
 			value_type *_data;
+			// Opened at the top of each profiled operation (empty with no_profiler)
+			typedef typename Profiler::scope _profiled;
+		// ====================  Range constructor  ====================
+			// vector(5, 42) lands in the range constructor: integral "iterators" are a fill
+			template <class Integer>
+			void initialize(Integer n, Integer val, ft::true_type)
+			{
+				_data = _alloc.allocate(n);
+				_capacity = n;
+				fill_fresh(_data, n, val);
+				_size = n;
+			};
+			template <class InputIterator>
+			void initialize(InputIterator first, InputIterator last, ft::false_type) { initialize_range(first, last, typename ft::iterator_tag<InputIterator>::type()); };
+			template <class InputIterator>
+			void initialize_range(InputIterator first, InputIterator last, ft::input_iterator_tag)
+			{
+				for (; first != last; ++first)
+					push_back(*first);
+			};
+			// Elements are only constructed: works for non assignable T (ex: pair<const K, V>)
+			template <class ForwardIterator>
+			void initialize_range(ForwardIterator first, ForwardIterator last, ft::forward_iterator_tag)
+			{
+				size_t n = ft::distance(first, last);
+				_data = _alloc.allocate(n);
+				_capacity = n;
+				construct_range(_data, first, last);
+				_size = n;
+			};
+		// ====================  Assign  ====================
+			template <class InputIterator>
+			void assign_range(InputIterator first, InputIterator last, ft::input_iterator_tag)
+			{
+				clear();
+				for (; first != last; ++first)
+					push_back(*first);
+			};
+			// Known length: exact reallocation if it doesn't fit, otherwise live slots are assigned and the rest constructed / destroyed
+			template <class ForwardIterator>
+			void assign_range(ForwardIterator first, ForwardIterator last, ft::forward_iterator_tag)
+			{
+				size_t n = ft::distance(first, last);
+				if (n > _capacity)
+				{
+					clear();
+					_alloc.deallocate(_data, _capacity);
+					_data = _alloc.allocate(n);
+					_capacity = n;
+					construct_range(_data, first, last);
+				}
+				else if (n > _size)
+				{
+					ForwardIterator mid = first;
+					for (size_t i = 0; i < _size; i++)
+						++mid;
+					std::copy(first, mid, _data);
+					construct_range(_data + _size, mid, last);
+				}
+				else
+				{
+					std::copy(first, last, _data);
+					for (size_t i = n; i < _size; i++)
+						_alloc.destroy(_data + i);
+				}
+				_size = n;
+			};
+		// ====================  Emplace  ====================
+			template <class Args>
+			void emplace_back_args(const Args &args)
+			{
+				_profiled profiled(ft::profile_push_back);
+				construct_back(args);
+			};
+			// At the end: built in place. Elsewhere: built once aside, then the insert path shifts the tail
+			// (1 copy + assignments, a rotate would cost a swap = 3 copies per element in C++98)
+			template <class Args>
+			iterator emplace_args(size_t pos, const Args &args)
+			{
+				_profiled profiled(ft::profile_insert);
+				if (pos == _size)
+					construct_back(args);
+				else
+				{
+					const value_type val = args.template make<value_type>();
+					grow(_size + 1);
+					insert_fill(pos, 1, val);
+				}
+				return iterator(_data + pos);
+			};
+			// On reallocation the new element is built before the old ones move: args may refer to them
+			template <class Args>
+			void construct_back(const Args &args)
+			{
+				if (_size == _capacity)
+				{
+					_profiled profiled(ft::profile_reallocate);
+					size_t capacity = Growth::next_capacity(_capacity, _size + 1, sizeof(T));
+					pointer tmp = _alloc.allocate(capacity);
+					args.construct(tmp + _size);
+					relocate(tmp, _data, _size, typename ft::relocation_category<T>::type());
+					_alloc.deallocate(_data, _capacity);
+					_data = tmp;
+					_capacity = capacity;
+				}
+				else
+					args.construct(_data + _size);
+				_size++;
+			};
+		// ====================  Growth  ====================
+			// Capacity for at least required elements, as much more as the growth policy says (reserve() stays exact)
+			void grow(size_t required)
+			{
+				if (required > _capacity)
+					reallocate(Growth::next_capacity(_capacity, required, sizeof(T)));
+			};
+			// Auto-trim after removals (compiled out when the policy doesn't trim); clear() keeps its buffer, like std
+			void trim()
+			{
+				size_t capacity = Growth::trim_capacity(_capacity, _size, sizeof(T));
+				if (capacity < _capacity)
+					reallocate(capacity);
+			};
+			// Exact capacity change, elements are relocated to the new buffer
+			void reallocate(size_t n)
+			{
+				_profiled profiled(ft::profile_reallocate);
+				pointer tmp = (n > 0) ? _alloc.allocate(n) : NULL;
+				relocate(tmp, _data, _size, typename ft::relocation_category<T>::type());
+				_alloc.deallocate(_data, _capacity);
+				_data = tmp;
+				_capacity = n;
+			};
+		// ====================  Element transfers  ====================
+			// true_type -> bytes are copied in bulk (memory bandwidth bound), false_type -> one copy constructor per element
+			typedef ft::is_trivially_copyable<T> _trivial;
+			// Copy n elements into raw memory
+			void copy_construct(pointer dst, const_pointer src, size_t n, ft::true_type)
+			{
+				if (n > 0)
+					std::memcpy(dst, src, n * sizeof(T));
+			};
+			void copy_construct(pointer dst, const_pointer src, size_t n, ft::false_type)
+			{
+				for (size_t i = 0; i < n; i++)
+					_alloc.construct(dst + i, src[i]);
+			};
+			// Move n elements into raw memory and destroy the sources (reallocation)
+			void relocate(pointer dst, pointer src, size_t n, ft::memcpy_relocation_tag) { copy_construct(dst, src, n, ft::true_type()); };
+			void relocate(pointer dst, pointer src, size_t n, ft::swap_relocation_tag)
+			{
+				const value_type empty = value_type();
+				for (size_t i = 0; i < n; i++)
+				{
+					_alloc.construct(dst + i, empty);
+					using std::swap;
+					swap(dst[i], src[i]);
+					_alloc.destroy(src + i);
+				}
+			};
+#if __cplusplus >= 201103L
+			void relocate(pointer dst, pointer src, size_t n, ft::move_relocation_tag)
+			{
+				for (size_t i = 0; i < n; i++)
+				{
+					::new (static_cast<void *>(dst + i)) value_type(std::move(src[i]));
+					_alloc.destroy(src + i);
+				}
+			};
+#endif
+			void relocate(pointer dst, pointer src, size_t n, ft::copy_relocation_tag)
+			{
+				copy_construct(dst, src, n, ft::false_type());
+				for (size_t i = 0; i < n; i++)
+					_alloc.destroy(src + i);
+			};
+			// Construct copies of val / of a range into raw memory
+			// true_type -> one memset when all the bytes of val are the same (0, -1, chars...), otherwise val is copied
+			// once and the filled part is doubled with memcpy (chunks kept small enough to stay in L1)
+			void construct_fill(pointer dst, size_t n, const value_type &val, ft::true_type)
+			{
+				if (n == 0)
+					return;
+				const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&val);
+				if (repeated_byte(val))
+				{
+					std::memset(static_cast<void *>(dst), bytes[0], n * sizeof(T));
+					return;
+				}
+				const size_t max_chunk = (sizeof(T) < 16384) ? 16384 / sizeof(T) : 1;
+				std::memcpy(static_cast<void *>(dst), bytes, sizeof(T));
+				for (size_t done = 1; done < n;)
+				{
+					size_t chunk = std::min(std::min(done, n - done), max_chunk);
+					std::memcpy(static_cast<void *>(dst + done), dst, chunk * sizeof(T));
+					done += chunk;
+				}
+			};
+			void construct_fill(pointer dst, size_t n, const value_type &val, ft::false_type)
+			{
+				for (size_t i = 0; i < n; i++)
+					_alloc.construct(dst + i, val);
+			};
+			static bool repeated_byte(const value_type &val)
+			{
+				const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&val);
+				for (size_t i = 1; i < sizeof(T); i++)
+					if (bytes[i] != bytes[0])
+						return false;
+				return true;
+			};
+			// Fill of a buffer straight from allocate(): zero filled memory (calloc_allocator) already holds zeros
+			void fill_fresh(pointer dst, size_t n, const value_type &val)
+			{
+				if (ft::allocates_zeroed<Alloc>::value && _trivial::value && repeated_byte(val) && *reinterpret_cast<const unsigned char *>(&val) == 0)
+					return;
+				construct_fill(dst, n, val, _trivial());
+			};
+			template <class InputIterator>
+			void construct_range(pointer dst, InputIterator first, InputIterator last)
+			{
+				for (; first != last; ++first, ++dst)
+					_alloc.construct(dst, *first);
+			};
+			// n copies of val at pos, capacity already there (val must not be an element of the vector)
+			void insert_fill(size_t pos, size_t n, const value_type &val)
+			{
+				size_t tail = _size - pos; // elements after the gap
+				if (tail > n)
+				{
+					copy_construct(_data + _size, _data + _size - n, n, _trivial()); // last n elements -> raw tail
+					std::copy_backward(_data + pos, _data + _size - n, _data + _size);
+					std::fill(_data + pos, _data + pos + n, val);
+				}
+				else
+				{
+					construct_fill(_data + _size, n - tail, val, _trivial()); // part of the gap past the old end
+					copy_construct(_data + pos + n, _data + pos, tail, _trivial());
+					std::fill(_data + pos, _data + _size, val);
+				}
+				_size += n;
+			};
+			// Single pass: elements are appended as they come, then the whole batch is inserted at pos
+			template <class InputIterator>
+			void insert_range(size_t pos, InputIterator first, InputIterator last, ft::input_iterator_tag)
+			{
+				if (pos == _size)
+				{
+					for (; first != last; ++first)
+						push_back(*first);
+					return;
+				}
+				// unprofiled: buffering isn't push_backs of this container, only the insert is timed
+				ft::vector<T, Alloc, Growth, ft::no_profiler> batch(_alloc);
+				for (; first != last; ++first)
+					batch.push_back(*first);
+				insert_range(pos, batch.data(), batch.data() + batch.size(), ft::random_access_iterator_tag());
+			};
+			template <class ForwardIterator>
+			void insert_range(size_t pos, ForwardIterator first, ForwardIterator last, ft::forward_iterator_tag)
+			{
+				size_t n = ft::distance(first, last);
+				grow(_size + n);
+				insert_range(pos, first, last, n);
+			};
+			// [first, last) (n elements) at pos, capacity already there
+			template <class ForwardIterator>
+			void insert_range(size_t pos, ForwardIterator first, ForwardIterator last, size_t n)
+			{
+				size_t tail = _size - pos;
+				if (tail > n)
+				{
+					copy_construct(_data + _size, _data + _size - n, n, _trivial());
+					std::copy_backward(_data + pos, _data + _size - n, _data + _size);
+					std::copy(first, last, _data + pos);
+				}
+				else
+				{
+					ForwardIterator mid = first;
+					for (size_t i = 0; i < tail; i++)
+						++mid;
+					construct_range(_data + _size, mid, last);
+					copy_construct(_data + pos + n, _data + pos, tail, _trivial());
+					std::copy(first, mid, _data + pos);
+				}
+				_size += n;
+			};
 	};
 	// ==================== Relational operators ====================
-	template <class T, class Alloc>
-	bool operator==(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+	// Contiguous buffers: RangeCompare.hpp picks memcmp / SIMD kernels for arithmetic T
+	template <class T, class Alloc, class Growth, class Profiler>
+	bool operator==(const vector<T, Alloc, Growth, Profiler> &lhs, const vector<T, Alloc, Growth, Profiler> &rhs)
 	{
-		if (lhs.size() != rhs.size())
-			return false;
-		for (size_t i = 0; i < lhs.size(); i++)
-			if (lhs[i] != rhs[i])
-				return false;
-		return true;
+		return lhs.size() == rhs.size() && ft::range_equal(lhs.data(), rhs.data(), lhs.size());
 	};
-	template <class T, class Alloc>
-	bool operator!=(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+	template <class T, class Alloc, class Growth, class Profiler>
+	bool operator!=(const vector<T, Alloc, Growth, Profiler> &lhs, const vector<T, Alloc, Growth, Profiler> &rhs)
 	{
-		if (lhs.size() != rhs.size())
-			return true;
-		for (size_t i = 0; i < lhs.size(); i++)
-			if (lhs[i] != rhs[i])
-				return true;
-		return false;
+		return !(lhs == rhs);
 	};
-	template <class T, class Alloc>
-	bool operator<(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+	template <class T, class Alloc, class Growth, class Profiler>
+	bool operator<(const vector<T, Alloc, Growth, Profiler> &lhs, const vector<T, Alloc, Growth, Profiler> &rhs)
 	{
-		size_t i = 0;
-		while (i < lhs.size() && i < rhs.size())
-		{
-			if (lhs[i] < rhs[i])
-				return true;
-			else if (lhs[i] > rhs[i])
-				return false;
-			i++;
-		}
-		if (i == lhs.size() && i != rhs.size())
-			return true;
-		return false;
+		return ft::range_compare(lhs.data(), lhs.size(), rhs.data(), rhs.size()) < 0;
 	};
-
-	template <class T, class Alloc>
-	bool operator<=(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+	template <class T, class Alloc, class Growth, class Profiler>
+	bool operator<=(const vector<T, Alloc, Growth, Profiler> &lhs, const vector<T, Alloc, Growth, Profiler> &rhs)
 	{
-		size_t i = 0;
-		while (i < lhs.size() && i < rhs.size())
-		{
-			if (lhs[i] < rhs[i])
-				return true;
-			else if (lhs[i] > rhs[i])
-				return false;
-			i++;
-		}
-		if (i == lhs.size() && i != rhs.size())
-			return true;
-		if (i == lhs.size() && i == rhs.size())
-			return true;
-		return false;
+		return ft::range_compare(lhs.data(), lhs.size(), rhs.data(), rhs.size()) <= 0;
 	};
-	template <class T, class Alloc>
-	bool operator>(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+	template <class T, class Alloc, class Growth, class Profiler>
+	bool operator>(const vector<T, Alloc, Growth, Profiler> &lhs, const vector<T, Alloc, Growth, Profiler> &rhs)
 	{
-		size_t i = 0;
-		while (i < lhs.size() && i < rhs.size())
-		{
-			if (lhs[i] < rhs[i])
-				return false;
-			else if (lhs[i] > rhs[i])
-				return true;
-			i++;
-		}
-		if (i != lhs.size() && i == rhs.size())
-			return true;
-		return false;
+		return ft::range_compare(lhs.data(), lhs.size(), rhs.data(), rhs.size()) > 0;
 	};
-	template <class T, class Alloc>
-	bool operator>=(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+	template <class T, class Alloc, class Growth, class Profiler>
+	bool operator>=(const vector<T, Alloc, Growth, Profiler> &lhs, const vector<T, Alloc, Growth, Profiler> &rhs)
 	{
-		size_t i = 0;
-		while (i < lhs.size() && i < rhs.size())
-		{
-			if (lhs[i] < rhs[i])
-				return false;
-			else if (lhs[i] > rhs[i])
-				return true;
-			i++;
-		}
-		if (i != lhs.size() && i == rhs.size())
-			return true;
-		if (i == lhs.size() && i == rhs.size())
-			return true;
-		return false;
+		return ft::range_compare(lhs.data(), lhs.size(), rhs.data(), rhs.size()) >= 0;
 	};
 	// Swap
-	template <class T, class Alloc>
-	void swap(vector<T, Alloc> &x, vector<T, Alloc> &y)
+	template <class T, class Alloc, class Growth, class Profiler>
+	void swap(vector<T, Alloc, Growth, Profiler> &x, vector<T, Alloc, Growth, Profiler> &y)
 	{
 		x.swap(y);
 	};
+	// Nested vectors are relocated by swapping their buffers
+	template <class T, class Alloc, class Growth, class Profiler>
+	struct is_swap_relocatable<vector<T, Alloc, Growth, Profiler> > : public true_type {};
 }
 
 #endif
\ No newline at end of file
@@ -9,7 +9,7 @@
 #else
 	#include "map.hpp"
 	#include "stack.hpp"
-	#include "vector.hpp"
+	#include "Vector.hpp"
 #endif
 
 #include <stdlib.h>
@@ -0,0 +1,890 @@
+#include "map.hpp"
+#include "Vector.hpp"
+#include "SmallVector.hpp"
+#include "TracingAllocator.hpp"
+#include "LatencyProfiler.hpp"
+#include "stack.hpp"
+#include "PoolAllocator.hpp"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <cstdlib>
+#include <vector>
+#include <list>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+#include <string>
+#include <malloc.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+/*
+	Regression benchmarks for ft containers
+	- ./ft_bench          -> run every benchmark
+	- ./ft_bench <name>   -> run only the benchmark called <name>
+*/
+
+// ==================== Helpers ====================
+static double now_ns()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Every operator new of the process is counted, so benchmarks can report how often they hit malloc
+// (kept out of line, otherwise gcc pairs the inlined malloc with delete expressions and warns)
+static size_t g_allocations = 0;
+
+__attribute__((noinline))
+#if __cplusplus >= 201103L
+void* operator new(size_t size)
+#else
+void* operator new(size_t size) throw(std::bad_alloc)
+#endif
+{
+	g_allocations++;
+	void* p = malloc(size ? size : 1);
+	if (p == NULL)
+		throw std::bad_alloc();
+	return p;
+}
+__attribute__((noinline))
+void operator delete(void* p) throw() { free(p); }
+
+// ==================== size() ====================
+// size() / empty() must stay flat from 10^3 to 10^7 elements
+static void bench_size()
+{
+	const size_t calls = 10000000;
+	ft::map<int, int> map_int;
+	int key = 0;
+	std::cout << "map::size()" << std::endl;
+	std::cout << std::setw(12) << "elements" << std::setw(16) << "ns/size()" << std::setw(16) << "ns/empty()" << std::endl;
+	for (size_t n = 1000; n <= 10000000; n *= 10)
+	{
+		while (map_int.size() < n)
+			map_int.insert(ft::make_pair(key++, 0));
+		volatile size_t sink = 0;
+		double start = now_ns();
+		for (size_t i = 0; i < calls; i++)
+			sink += map_int.size();
+		double size_ns = (now_ns() - start) / calls;
+		start = now_ns();
+		for (size_t i = 0; i < calls; i++)
+			sink += map_int.empty();
+		double empty_ns = (now_ns() - start) / calls;
+		std::cout << std::setw(12) << n << std::setw(16) << std::fixed << std::setprecision(3) << size_ns << std::setw(16) << empty_ns << std::endl;
+	}
+}
+
+// ==================== Hinted insert ====================
+enum key_order { SORTED, REVERSE_SORTED, RANDOM };
+
+static std::vector<int> make_keys(size_t n, key_order order)
+{
+	std::vector<int> keys(n);
+	for (size_t i = 0; i < n; i++)
+		keys[i] = static_cast<int>(i);
+	if (order == REVERSE_SORTED)
+		std::reverse(keys.begin(), keys.end());
+	else if (order == RANDOM)
+	{
+		srand(42);
+		for (size_t i = n - 1; i > 0; i--)
+			std::swap(keys[i], keys[rand() % (i + 1)]);
+	}
+	return keys;
+}
+
+// hint = position returned by the previous insert (end() for the first one), what an ingest loop naturally does
+static double insert_ns(const std::vector<int>& keys, bool hinted)
+{
+	ft::map<int, int> map_int;
+	ft::map<int, int>::iterator hint = map_int.end();
+	double start = now_ns();
+	for (size_t i = 0; i < keys.size(); i++)
+	{
+		if (hinted)
+			hint = map_int.insert(hint, ft::make_pair(keys[i], 0));
+		else
+			map_int.insert(ft::make_pair(keys[i], 0));
+	}
+	return (now_ns() - start) / keys.size();
+}
+
+// sorted: hint = previous node -> new key goes right after it
+// reverse sorted: hint = previous node -> new key goes right before it
+// random: hint is almost always wrong -> measures the fallback overhead
+static void bench_hint()
+{
+	const size_t n = 1000000;
+	const char* names[] = { "sorted", "reverse sorted", "random" };
+	std::cout << "map::insert(hint, value) vs map::insert(value), " << n << " keys" << std::endl;
+	std::cout << std::setw(16) << "order" << std::setw(16) << "ns/hinted" << std::setw(16) << "ns/unhinted" << std::endl;
+	for (int order = SORTED; order <= RANDOM; order++)
+	{
+		std::vector<int> keys = make_keys(n, static_cast<key_order>(order));
+		double hinted = insert_ns(keys, true);
+		double unhinted = insert_ns(keys, false);
+		std::cout << std::setw(16) << names[order] << std::setw(16) << std::fixed << std::setprecision(1) << hinted << std::setw(16) << unhinted << std::endl;
+	}
+}
+
+// ==================== Bulk build ====================
+// range constructor from a sorted snapshot vs inserting the same snapshot one element at a time
+static void bench_bulk()
+{
+	std::cout << "map(first, last) from sorted input vs one insert per element" << std::endl;
+	std::cout << std::setw(12) << "elements" << std::setw(16) << "ns/range" << std::setw(16) << "ns/insert" << std::endl;
+	for (size_t n = 1000; n <= 1000000; n *= 10)
+	{
+		std::vector<ft::pair<int, int> > snapshot;
+		for (size_t i = 0; i < n; i++)
+			snapshot.push_back(ft::make_pair(static_cast<int>(i), 0));
+		double start = now_ns();
+		{
+			ft::map<int, int> map_int(snapshot.begin(), snapshot.end());
+		}
+		double range_ns = (now_ns() - start) / n;
+		start = now_ns();
+		{
+			ft::map<int, int> map_int;
+			for (size_t i = 0; i < n; i++)
+				map_int.insert(snapshot[i]);
+		}
+		double insert_ns = (now_ns() - start) / n;
+		std::cout << std::setw(12) << n << std::setw(16) << std::fixed << std::setprecision(1) << range_ns << std::setw(16) << insert_ns << std::endl;
+	}
+}
+
+// ==================== Copy ====================
+// copy constructor && assignment of a map with random keys (same workload as main.cpp's copy)
+static void bench_copy()
+{
+	std::cout << "map copy / assignment" << std::endl;
+	std::cout << std::setw(12) << "elements" << std::setw(16) << "ns/copy" << std::setw(16) << "ns/assign" << std::endl;
+	srand(42);
+	for (size_t n = 1000; n <= 1000000; n *= 10)
+	{
+		ft::map<int, int> map_int;
+		while (map_int.size() < n)
+			map_int.insert(ft::make_pair(rand(), rand()));
+		double start = now_ns();
+		ft::map<int, int> copy = map_int;
+		double copy_ns = (now_ns() - start) / n;
+		ft::map<int, int> assigned;
+		assigned[1] = 1;
+		start = now_ns();
+		assigned = map_int;
+		double assign_ns = (now_ns() - start) / n;
+		std::cout << std::setw(12) << n << std::setw(16) << std::fixed << std::setprecision(1) << copy_ns << std::setw(16) << assign_ns << std::endl;
+	}
+}
+
+// ==================== Pooled nodes ====================
+// insert / erase / re-insert / clear cycle with random keys, std::allocator vs ft::pool_allocator
+template <class Map>
+static void pool_cycle(const char* name, const std::vector<int>& keys)
+{
+	size_t n = keys.size();
+	Map map_int;
+	size_t allocations = g_allocations;
+	double start = now_ns();
+	for (size_t i = 0; i < n; i++)
+		map_int.insert(ft::make_pair(keys[i], 0));
+	double insert_ns = (now_ns() - start) / n;
+	start = now_ns();
+	for (size_t i = 0; i < n; i++)
+		map_int.erase(keys[n - 1 - i]);
+	double erase_ns = (now_ns() - start) / n;
+	start = now_ns();
+	for (size_t i = 0; i < n; i++)
+		map_int.insert(ft::make_pair(keys[i], 0));
+	double reinsert_ns = (now_ns() - start) / n;
+	start = now_ns();
+	map_int.clear();
+	double clear_ns = (now_ns() - start) / n;
+	allocations = g_allocations - allocations;
+	std::cout << std::setw(18) << name << std::setw(14) << allocations << std::setw(12) << std::fixed << std::setprecision(1) << insert_ns << std::setw(12) << erase_ns << std::setw(12) << reinsert_ns << std::setw(12) << clear_ns << std::endl;
+}
+
+static void bench_pool()
+{
+	const size_t n = 1000000;
+	std::vector<int> keys = make_keys(n, RANDOM);
+	std::cout << "map<int, int> node allocation, " << n << " random keys (ns per element)" << std::endl;
+	std::cout << std::setw(18) << "allocator" << std::setw(14) << "operator new" << std::setw(12) << "insert" << std::setw(12) << "erase" << std::setw(12) << "re-insert" << std::setw(12) << "clear" << std::endl;
+	pool_cycle<ft::map<int, int> >("std::allocator", keys);
+	pool_cycle<ft::map<int, int, std::less<int>, ft::pool_allocator<ft::pair<const int, int> > > >("ft::pool_allocator", keys);
+}
+
+// ==================== Node footprint ====================
+// node layout before packing the color: parent, left, right, data, int color
+template <class V>
+struct padded_node
+{
+	padded_node* parent;
+	padded_node* left;
+	padded_node* right;
+	V data;
+	int color;
+};
+
+// bytes malloc really hands out for one node (glibc: usable size + 8 bytes of chunk header)
+static size_t heap_bytes(size_t size)
+{
+	void* p = malloc(size);
+	size_t bytes = malloc_usable_size(p) + sizeof(size_t);
+	free(p);
+	return bytes;
+}
+
+template <class K, class V>
+static void node_footprint(const char* name)
+{
+	typedef ft::pair<const K, V> value_type;
+	size_t before = sizeof(padded_node<value_type>);
+	size_t after = sizeof(typename RedBlackTree<value_type>::rb_node);
+	std::cout << std::setw(28) << name << std::setw(12) << before << std::setw(12) << after << std::setw(14) << heap_bytes(before) << std::setw(14) << heap_bytes(after) << std::endl;
+}
+
+static void bench_node()
+{
+	std::cout << "bytes per element (node size, then heap chunk with std::allocator)" << std::endl;
+	std::cout << std::setw(28) << "map" << std::setw(12) << "padded" << std::setw(12) << "packed" << std::setw(14) << "heap padded" << std::setw(14) << "heap packed" << std::endl;
+	node_footprint<int, int>("map<int, int>");
+	node_footprint<long, long>("map<long, long>");
+	node_footprint<double, double>("map<double, double>");
+	node_footprint<int, std::string>("map<int, std::string>");
+	node_footprint<std::string, int>("map<std::string, int>");
+}
+
+// ==================== Vector transfers ====================
+// same element as main.cpp: trivially copyable, 4 KB -> growth and shifts are plain memcpy / memmove
+struct buffer
+{
+	int idx;
+	char buff[4096];
+};
+
+template <class Vector>
+static double push_back_ns(size_t n)
+{
+	Vector v;
+	buffer b;
+	std::memset(&b, 0, sizeof(b));
+	double start = now_ns();
+	for (size_t i = 0; i < n; i++)
+	{
+		b.idx = static_cast<int>(i);
+		v.push_back(b);
+	}
+	return (now_ns() - start) / n;
+}
+
+// inserts at the front then erases from the front: every call shifts the whole vector
+template <class Vector>
+static double front_shift_ns(size_t n)
+{
+	Vector v;
+	double start = now_ns();
+	for (size_t i = 0; i < n; i++)
+		v.insert(v.begin(), static_cast<int>(i));
+	for (size_t i = 0; i < n; i++)
+		v.erase(v.begin());
+	return (now_ns() - start) / (2 * n);
+}
+
+// every string is long enough to live on the heap: a copy-based regrowth allocates once per element
+template <class Vector>
+static void push_back_strings(const char* name, size_t n)
+{
+	const std::string str(32, 'x');
+	size_t allocations = g_allocations;
+	double start = now_ns();
+	{
+		Vector v;
+		for (size_t i = 0; i < n; i++)
+			v.push_back(str);
+	}
+	double ns = (now_ns() - start) / n;
+	allocations = g_allocations - allocations;
+	std::cout << std::setw(32) << name << std::setw(14) << std::fixed << std::setprecision(1) << ns << std::setw(14) << allocations << std::endl;
+}
+
+// forward range (std::list): length known up front -> one allocation
+// input range (istream_iterator): read once, grows as it goes
+template <class Vector>
+static void assign_ranges(const char* name, const std::list<int>& list, const std::string& text)
+{
+	Vector v;
+	size_t allocations = g_allocations;
+	double start = now_ns();
+	v.assign(list.begin(), list.end());
+	double list_ns = (now_ns() - start) / list.size();
+	size_t list_allocations = g_allocations - allocations;
+	Vector w;
+	std::istringstream in(text);
+	start = now_ns();
+	w.assign(std::istream_iterator<int>(in), std::istream_iterator<int>());
+	double stream_ns = (now_ns() - start) / list.size();
+	std::cout << std::setw(32) << name << std::setw(14) << list_allocations << std::setw(14) << std::fixed << std::setprecision(1) << list_ns << std::setw(14) << stream_ns << std::endl;
+}
+
+static void bench_vector()
+{
+	const size_t buffers = 65536;
+	const size_t ints = 100000;
+	std::cout << "vector element transfers (ns per call)" << std::endl;
+	std::cout << std::setw(32) << "operation" << std::setw(14) << "ft::vector" << std::setw(14) << "std::vector" << std::endl;
+	double ft_ns = push_back_ns<ft::vector<buffer> >(buffers);
+	double std_ns = push_back_ns<std::vector<buffer> >(buffers);
+	std::cout << std::setw(32) << "push_back 4 KB struct (x65536)" << std::setw(14) << std::fixed << std::setprecision(1) << ft_ns << std::setw(14) << std_ns << std::endl;
+	ft_ns = front_shift_ns<ft::vector<int> >(ints);
+	std_ns = front_shift_ns<std::vector<int> >(ints);
+	std::cout << std::setw(32) << "insert/erase front int (x100000)" << std::setw(14) << ft_ns << std::setw(14) << std_ns << std::endl;
+	std::cout << std::endl << "vector<std::string> push_back, 1000000 heap strings" << std::endl;
+	std::cout << std::setw(32) << "vector" << std::setw(14) << "ns/push_back" << std::setw(14) << "operator new" << std::endl;
+	push_back_strings<ft::vector<std::string> >("ft::vector", 1000000);
+	push_back_strings<std::vector<std::string> >("std::vector", 1000000);
+	std::list<int> list;
+	std::ostringstream text;
+	for (int i = 0; i < 1000000; i++)
+	{
+		list.push_back(i);
+		text << i << ' ';
+	}
+	std::cout << std::endl << "assign(first, last) of 1000000 ints" << std::endl;
+	std::cout << std::setw(32) << "vector" << std::setw(14) << "list allocs" << std::setw(14) << "ns/list elem" << std::setw(14) << "ns/istream" << std::endl;
+	assign_ranges<ft::vector<int> >("ft::vector", list, text.str());
+	assign_ranges<std::vector<int> >("std::vector", list, text.str());
+}
+
+// ==================== Growth policies ====================
+// each run is a child process: its peak RSS (wait4) only covers that policy
+template <class Vector>
+static void buffer_growth(const char* name, size_t n)
+{
+	std::cout.flush();
+	pid_t pid = fork();
+	if (pid == 0)
+	{
+		double start = now_ns();
+		size_t allocations = g_allocations;
+		Vector v;
+		buffer b;
+		std::memset(&b, 0, sizeof(b));
+		for (size_t i = 0; i < n; i++)
+			v.push_back(b);
+		allocations = g_allocations - allocations;
+		double ms = (now_ns() - start) / 1e6;
+		std::cout << std::setw(20) << name << std::setw(10) << allocations << std::setw(12) << std::fixed << std::setprecision(1) << ms << std::setw(14) << v.capacity() * sizeof(buffer) / (1024 * 1024) << std::setw(8) << "";
+		std::cout.flush();
+		_exit(0);
+	}
+	int status;
+	struct rusage usage;
+	wait4(pid, &status, 0, &usage);
+	std::cout << usage.ru_maxrss / 1024 << std::endl;
+}
+
+// appending small ranges: with exact growth every insert reallocates
+template <class Vector>
+static void range_growth(const char* name, size_t inserts)
+{
+	int chunk[16] = { 0 };
+	size_t allocations = g_allocations;
+	double start = now_ns();
+	{
+		Vector v;
+		for (size_t i = 0; i < inserts; i++)
+			v.insert(v.end(), chunk, chunk + 16);
+	}
+	double ms = (now_ns() - start) / 1e6;
+	allocations = g_allocations - allocations;
+	std::cout << std::setw(20) << name << std::setw(10) << allocations << std::setw(12) << std::fixed << std::setprecision(1) << ms << std::endl;
+}
+
+// load peak then drop: 10^6 elements, back down to 1 %
+template <class Vector>
+static void load_drop(const char* name, bool shrink)
+{
+	Vector v;
+	for (int i = 0; i < 1000000; i++)
+		v.push_back(i);
+	size_t allocations = g_allocations;
+	double start = now_ns();
+	while (v.size() > 10000)
+		v.pop_back();
+	if (shrink)
+		v.shrink_to_fit();
+	double ns = (now_ns() - start) / (1000000 - 10000);
+	allocations = g_allocations - allocations;
+	std::cout << std::setw(20) << name << std::setw(10) << allocations << std::setw(12) << std::fixed << std::setprecision(1) << ns << std::setw(16) << v.bytes_reserved() << std::setw(14) << v.bytes_used() << std::endl;
+}
+
+static void bench_growth()
+{
+	const size_t buffers = 100000;
+	std::cout << "push_back of " << buffers << " 4 KB structs (~400 MB) per growth policy" << std::endl;
+	std::cout << std::setw(20) << "policy" << std::setw(10) << "reallocs" << std::setw(12) << "ms" << std::setw(14) << "capacity MB" << std::setw(8) << "" << "peak RSS MB" << std::endl;
+	buffer_growth<ft::vector<buffer, std::allocator<buffer>, ft::doubling_growth> >("doubling", buffers);
+	buffer_growth<ft::vector<buffer, std::allocator<buffer>, ft::factor_1_5_growth> >("1.5x", buffers);
+	buffer_growth<ft::vector<buffer, std::allocator<buffer>, ft::huge_page_growth> >("2 MB pages", buffers);
+	buffer_growth<ft::vector<buffer, std::allocator<buffer>, ft::capped_growth> >("capped 64 MB steps", buffers);
+	const size_t inserts = 20000;
+	std::cout << std::endl << inserts << " range inserts of 16 ints at the end" << std::endl;
+	std::cout << std::setw(20) << "policy" << std::setw(10) << "reallocs" << std::setw(12) << "ms" << std::endl;
+	range_growth<ft::vector<int, std::allocator<int>, ft::growth_policy<1, 1> > >("exact (no growth)", inserts);
+	range_growth<ft::vector<int, std::allocator<int>, ft::doubling_growth> >("doubling", inserts);
+	range_growth<ft::vector<int, std::allocator<int>, ft::factor_1_5_growth> >("1.5x", inserts);
+	std::cout << std::endl << "10^6 ints popped down to 10^4" << std::endl;
+	std::cout << std::setw(20) << "policy" << std::setw(10) << "reallocs" << std::setw(12) << "ns/pop" << std::setw(16) << "bytes reserved" << std::setw(14) << "bytes used" << std::endl;
+	load_drop<ft::vector<int> >("doubling", false);
+	load_drop<ft::vector<int> >("+ shrink_to_fit", true);
+	load_drop<ft::vector<int, std::allocator<int>, ft::trimming_growth> >("trim under 25 %", false);
+}
+
+// ==================== Emplace ====================
+// 256 bytes of payload: every redundant temporary is a 256 byte copy
+struct record
+{
+	int id;
+	char payload[252];
+	record() : id(0) { std::memset(this->payload, 0, sizeof(this->payload)); }
+	explicit record(int i) : id(i) { std::memset(this->payload, i, sizeof(this->payload)); }
+};
+
+static void bench_emplace()
+{
+	const size_t n = 1000000;
+	std::cout << "construction in place, " << n << " elements (ns per call)" << std::endl;
+	std::cout << std::setw(36) << "operation" << std::setw(14) << "copy" << std::setw(14) << "emplace" << std::endl;
+	double copy_ns;
+	double emplace_ns;
+	{
+		ft::vector<record> v;
+		double start = now_ns();
+		for (size_t i = 0; i < n; i++)
+			v.push_back(record(static_cast<int>(i)));
+		copy_ns = (now_ns() - start) / n;
+	}
+	{
+		ft::vector<record> v;
+		double start = now_ns();
+		for (size_t i = 0; i < n; i++)
+			v.emplace_back(static_cast<int>(i));
+		emplace_ns = (now_ns() - start) / n;
+	}
+	std::cout << std::setw(36) << "vector push_back / emplace_back" << std::setw(14) << std::fixed << std::setprecision(1) << copy_ns << std::setw(14) << emplace_ns << std::endl;
+	std::vector<int> keys = make_keys(n / 10, RANDOM);
+	ft::map<int, record> map_record;
+	for (size_t i = 0; i < keys.size(); i++)
+		map_record.try_emplace(keys[i], keys[i]);
+	// hits: operator[] used to build a default record + a pair before finding the key
+	double start = now_ns();
+	for (size_t i = 0; i < n; i++)
+		map_record.insert(ft::make_pair(keys[i % keys.size()], record())).first->second.id++;
+	copy_ns = (now_ns() - start) / n;
+	start = now_ns();
+	for (size_t i = 0; i < n; i++)
+		map_record[keys[i % keys.size()]].id++;
+	emplace_ns = (now_ns() - start) / n;
+	std::cout << std::setw(36) << "map hit: insert(pair) / operator[]" << std::setw(14) << copy_ns << std::setw(14) << emplace_ns << std::endl;
+}
+
+// ==================== small_vector ====================
+// short-lived vectors of 0 to 64 elements: small_vector<int, 16> shouldn't touch malloc up to 16
+template <class Vector>
+static void small_cycle(size_t size, size_t rounds, double& ns, double& allocations)
+{
+	size_t before = g_allocations;
+	long sum = 0;
+	double start = now_ns();
+	for (size_t r = 0; r < rounds; r++)
+	{
+		Vector v;
+		for (size_t i = 0; i < size; i++)
+			v.push_back(static_cast<int>(i + r));
+		for (size_t i = 0; i < v.size(); i++)
+			sum += v[i];
+	}
+	ns = (now_ns() - start) / rounds;
+	allocations = static_cast<double>(g_allocations - before) / rounds;
+	if (sum == 42)
+		std::cout << "";
+}
+
+static void bench_small()
+{
+	const size_t rounds = 200000;
+	std::cout << "short-lived vectors, " << rounds << " rounds (ns and operator new per vector)" << std::endl;
+	std::cout << std::setw(8) << "size" << std::setw(14) << "vector ns" << std::setw(14) << "vector new" << std::setw(14) << "small ns" << std::setw(14) << "small new" << std::endl;
+	for (size_t size = 0; size <= 64; size = (size == 0) ? 1 : size * 2)
+	{
+		double vector_ns, vector_allocations, small_ns, small_allocations;
+		small_cycle<ft::vector<int> >(size, rounds, vector_ns, vector_allocations);
+		small_cycle<ft::small_vector<int, 16> >(size, rounds, small_ns, small_allocations);
+		std::cout << std::setw(8) << size << std::setw(14) << std::fixed << std::setprecision(1) << vector_ns << std::setw(14) << std::setprecision(2) << vector_allocations
+			<< std::setw(14) << std::setprecision(1) << small_ns << std::setw(14) << std::setprecision(2) << small_allocations << std::endl;
+	}
+	// small_vector as the Container of a stack
+	double stack_ns[2];
+	size_t stack_allocations[2];
+	for (int which = 0; which < 2; which++)
+	{
+		size_t before = g_allocations;
+		long sum = 0;
+		double start = now_ns();
+		for (size_t r = 0; r < rounds; r++)
+		{
+			if (which == 0)
+			{
+				ft::stack<int> s;
+				for (int i = 0; i < 8; i++)
+					s.push(i);
+				sum += s.top();
+			}
+			else
+			{
+				ft::stack<int, ft::small_vector<int, 16> > s;
+				for (int i = 0; i < 8; i++)
+					s.push(i);
+				sum += s.top();
+			}
+		}
+		stack_ns[which] = (now_ns() - start) / rounds;
+		stack_allocations[which] = g_allocations - before;
+		if (sum == 42)
+			std::cout << "";
+	}
+	std::cout << std::setw(36) << "stack of 8 (vector / small_vector)" << std::setw(10) << std::setprecision(1) << stack_ns[0] << " ns " << std::setw(8) << stack_allocations[0] << " new"
+		<< std::setw(10) << stack_ns[1] << " ns " << std::setw(8) << stack_allocations[1] << " new" << std::endl;
+}
+
+// ==================== Relational operators ====================
+// equal vectors (== scans everything) and vectors differing on the last element (< scans everything)
+// loop = the element by element comparison the operators used before
+template <class T>
+static bool loop_less(const ft::vector<T>& lhs, const ft::vector<T>& rhs)
+{
+	for (size_t i = 0; i < lhs.size() && i < rhs.size(); i++)
+	{
+		if (lhs[i] < rhs[i])
+			return true;
+		if (lhs[i] > rhs[i])
+			return false;
+	}
+	return lhs.size() < rhs.size();
+}
+
+template <class T>
+static bool loop_equal(const ft::vector<T>& lhs, const ft::vector<T>& rhs)
+{
+	if (lhs.size() != rhs.size())
+		return false;
+	for (size_t i = 0; i < lhs.size(); i++)
+		if (lhs[i] != rhs[i])
+			return false;
+	return true;
+}
+
+template <class T>
+static void compare_sizes(const char* name)
+{
+	const size_t sizes[] = { 1024, 1024 * 1024, 100 * 1024 * 1024 };
+	for (size_t s = 0; s < 3; s++)
+	{
+		size_t n = sizes[s] / sizeof(T);
+		size_t rounds = (256 * 1024 * 1024) / sizes[s];
+		ft::vector<T> a;
+		for (size_t i = 0; i < n; i++)
+			a.push_back(static_cast<T>(i % 100));
+		ft::vector<T> b(a);
+		ft::vector<T> c(a);
+		c[n - 1] = static_cast<T>(100);
+		size_t hits = 0;
+		double ns[4];
+		double start = now_ns();
+		for (size_t r = 0; r < rounds; r++)
+			hits += loop_equal(a, b);
+		ns[0] = now_ns() - start;
+		start = now_ns();
+		for (size_t r = 0; r < rounds; r++)
+			hits += (a == b);
+		ns[1] = now_ns() - start;
+		start = now_ns();
+		for (size_t r = 0; r < rounds; r++)
+			hits += loop_less(a, c);
+		ns[2] = now_ns() - start;
+		start = now_ns();
+		for (size_t r = 0; r < rounds; r++)
+			hits += (a < c);
+		ns[3] = now_ns() - start;
+		if (hits != 4 * rounds)
+			std::cout << "wrong result" << std::endl;
+		// GB/s over both vectors
+		std::cout << std::setw(16) << name << std::setw(10) << sizes[s] / 1024 << std::fixed << std::setprecision(1);
+		for (int i = 0; i < 4; i++)
+			std::cout << std::setw(12) << (2.0 * sizes[s] * rounds) / ns[i];
+		std::cout << std::endl;
+	}
+}
+
+static void bench_compare()
+{
+	std::cout << "vector comparisons (GB/s read, sizes in KB)" << std::endl;
+	std::cout << std::setw(16) << "type" << std::setw(10) << "KB" << std::setw(12) << "loop ==" << std::setw(12) << "==" << std::setw(12) << "loop <" << std::setw(12) << "<" << std::endl;
+	compare_sizes<unsigned char>("unsigned char");
+	compare_sizes<int>("int");
+	compare_sizes<double>("double");
+}
+
+// ==================== Bulk fill ====================
+// ns per element: fill constructor, resize with a value, zero fills (std::allocator vs calloc), resize without init
+template <class Vector>
+static double fill_ns(size_t n, const typename Vector::value_type& val)
+{
+	double start = now_ns();
+	Vector v(n, val);
+	double ns = (now_ns() - start) / n;
+	if (std::memcmp(&v[n / 2], &val, sizeof(val)) == 0)
+		return ns;
+	return -1;
+}
+
+template <class Vector>
+static double resize_ns(size_t n, const typename Vector::value_type& val)
+{
+	Vector v;
+	double start = now_ns();
+	for (size_t i = 1; i <= 64; i++)
+		v.resize(n * i / 64, val);
+	return (now_ns() - start) / n;
+}
+
+static double uninitialized_ns(size_t n)
+{
+	ft::vector<int> v;
+	double start = now_ns();
+	for (size_t i = 1; i <= 64; i++)
+		v.resize_uninitialized(n * i / 64);
+	return (now_ns() - start) / n;
+}
+
+static void bench_fill()
+{
+	const size_t n = 32 * 1024 * 1024;
+	const size_t big = 16 * 1024;
+	buffer b;
+	std::memset(&b, 0, sizeof(b));
+	b.idx = 42;
+	std::cout << "bulk fills (ns per element, " << n << " ints / " << big << " 4KB buffers)" << std::endl;
+	std::cout << std::setw(36) << "operation" << std::setw(12) << "ft" << std::setw(12) << "std" << std::endl;
+	std::cout << std::fixed << std::setprecision(3);
+	std::cout << std::setw(36) << "vector<int>(n, 0x01020304)" << std::setw(12) << fill_ns<ft::vector<int> >(n, 0x01020304) << std::setw(12) << fill_ns<std::vector<int> >(n, 0x01020304) << std::endl;
+	std::cout << std::setw(36) << "vector<int>(n)" << std::setw(12) << fill_ns<ft::vector<int> >(n, 0) << std::setw(12) << fill_ns<std::vector<int> >(n, 0) << std::endl;
+	std::cout << std::setw(36) << "vector<int, calloc_allocator>(n)" << std::setw(12) << fill_ns<ft::vector<int, ft::calloc_allocator<int> > >(n, 0) << std::setw(12) << "-" << std::endl;
+	std::cout << std::setw(36) << "vector<buffer>(n, b)" << std::setw(12) << fill_ns<ft::vector<buffer> >(big, b) << std::setw(12) << fill_ns<std::vector<buffer> >(big, b) << std::endl;
+	std::cout << std::setw(36) << "resize(n, buffer) in 64 steps" << std::setw(12) << resize_ns<ft::vector<buffer> >(big, b) << std::setw(12) << resize_ns<std::vector<buffer> >(big, b) << std::endl;
+	std::cout << std::setw(36) << "resize(n, int) in 64 steps" << std::setw(12) << resize_ns<ft::vector<int> >(n, 7) << std::setw(12) << resize_ns<std::vector<int> >(n, 7) << std::endl;
+	std::cout << std::setw(36) << "resize_uninitialized(n) in 64 steps" << std::setw(12) << uninitialized_ns(n) << std::setw(12) << "-" << std::endl;
+}
+
+// ==================== Tracing allocator ====================
+// cost of leaving the allocation counters on: same work through std::allocator and tracing_allocator
+template <class Map>
+static double map_churn_ns(const std::vector<int>& keys, const typename Map::allocator_type& alloc)
+{
+	double start = now_ns();
+	{
+		Map m(std::less<int>(), alloc);
+		for (size_t i = 0; i < keys.size(); i++)
+			m.insert(ft::make_pair(keys[i], keys[i]));
+		for (size_t i = 0; i < keys.size(); i += 2)
+			m.erase(keys[i]);
+	}
+	return (now_ns() - start) / keys.size();
+}
+
+template <class Vector>
+static double vector_churn_ns(size_t n, const typename Vector::allocator_type& alloc)
+{
+	double start = now_ns();
+	for (size_t round = 0; round < n / 64; round++)
+	{
+		Vector v(alloc);
+		for (size_t i = 0; i < 64; i++)
+			v.push_back(static_cast<int>(i));
+	}
+	return (now_ns() - start) / n;
+}
+
+static void bench_tracing()
+{
+	typedef ft::map<int, int> plain_map;
+	typedef ft::map<int, int, std::less<int>, ft::tracing_allocator<ft::pair<const int, int> > > traced_map;
+	typedef ft::vector<int, ft::tracing_allocator<int> > traced_vector;
+	const size_t n = 1000000;
+	std::vector<int> keys = make_keys(n, RANDOM);
+	ft::allocation_stats map_stats;
+	ft::allocation_stats vector_stats;
+	std::cout << "allocation tracing overhead (ns per element)" << std::endl;
+	std::cout << std::setw(36) << "workload" << std::setw(14) << "std::alloc" << std::setw(14) << "tracing" << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << std::setw(36) << "map insert + erase half" << std::setw(14) << map_churn_ns<plain_map>(keys, plain_map::allocator_type())
+		<< std::setw(14) << map_churn_ns<traced_map>(keys, traced_map::allocator_type(&map_stats)) << std::endl;
+	std::cout << std::setw(36) << "64 push_back per vector" << std::setw(14) << vector_churn_ns<ft::vector<int> >(n * 16, std::allocator<int>())
+		<< std::setw(14) << vector_churn_ns<traced_vector>(n * 16, traced_vector::allocator_type(&vector_stats)) << std::endl;
+	std::cout << "map stats:" << std::endl;
+	map_stats.dump(std::cout);
+	std::cout << "vector stats:" << std::endl;
+	vector_stats.dump(std::cout);
+}
+
+// ==================== Tree shape ====================
+// height / black height / depth per insertion order, + operation counters when built with -DFT_RBT_STATS (make bench_stats)
+static void bench_tree()
+{
+	const size_t n = 1000000;
+	const char* names[] = { "sorted", "reverse sorted", "random" };
+	for (int order = SORTED; order <= RANDOM; order++)
+	{
+		typedef RedBlackTree<int> tree_type;
+		std::vector<int> keys = make_keys(n, static_cast<key_order>(order));
+#ifdef FT_RBT_STATS
+		tree_type::stats().reset();
+#endif
+		tree_type tree;
+		for (size_t i = 0; i < keys.size(); i++)
+			tree.insert_unique(keys[i]);
+		for (size_t i = 0; i < keys.size(); i += 2)
+			tree.find(keys[i]);
+		for (size_t i = 0; i < keys.size(); i += 4)
+			tree.remove(tree.find(keys[i]));
+		size_t sum = 0;
+		for (tree_type::iterator it = tree.begin(); it != tree.end(); ++it)
+			sum += *it;
+		std::cout << names[order] << " inserts, half looked up, a quarter erased, one walk (sum " << sum << ")" << std::endl;
+		tree.dump(std::cout);
+	}
+}
+
+// ==================== Latency profile ====================
+// sampled latency histograms of push_back / map operations, + cost of sampling vs no_profiler
+struct vector_profile_tag {};
+struct map_profile_tag {};
+
+template <class Vector>
+static double profiled_push_back_ns(size_t n)
+{
+	double start = now_ns();
+	{
+		Vector v;
+		for (size_t i = 0; i < n; i++)
+			v.push_back(static_cast<int>(i));
+	}
+	return (now_ns() - start) / n;
+}
+
+template <class Map>
+static double profiled_map_ns(const std::vector<int>& keys)
+{
+	double start = now_ns();
+	{
+		Map m;
+		for (size_t i = 0; i < keys.size(); i++)
+			m.insert(ft::make_pair(keys[i], keys[i]));
+		for (size_t i = 0; i < keys.size(); i++)
+			m.find(keys[i]);
+		for (size_t i = 0; i < keys.size(); i += 2)
+			m.erase(keys[i]);
+	}
+	return (now_ns() - start) / keys.size();
+}
+
+static void bench_profile()
+{
+	typedef ft::sampling_profiler<vector_profile_tag> vector_profiler;
+	typedef ft::sampling_profiler<map_profile_tag> map_profiler;
+	typedef ft::vector<int, std::allocator<int>, ft::doubling_growth, vector_profiler> profiled_vector;
+	typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, map_profiler> profiled_map;
+	const size_t n = 1000000;
+	std::vector<int> keys = make_keys(n / 10, RANDOM);
+	std::cout << "sampling overhead (ns per element)" << std::endl;
+	std::cout << std::setw(36) << "workload" << std::setw(14) << "no_profiler" << std::setw(14) << "sampling" << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+	// best of several runs, the map ones alternated: the map workload is sensitive to the heap
+	// the previous run left behind, single runs are noisy
+	double vector_ns[2] = { 1e30, 1e30 };
+	double map_ns[2] = { 1e30, 1e30 };
+	for (int round = 0; round < 3; round++)
+	{
+		vector_ns[0] = std::min(vector_ns[0], profiled_push_back_ns<ft::vector<int> >(n * 16));
+		vector_ns[1] = std::min(vector_ns[1], profiled_push_back_ns<profiled_vector>(n * 16));
+	}
+	for (int round = 0; round < 4; round++)
+	{
+		if (round % 2 == 0)
+			map_ns[0] = std::min(map_ns[0], profiled_map_ns<ft::map<int, int> >(keys));
+		map_ns[1] = std::min(map_ns[1], profiled_map_ns<profiled_map>(keys));
+		if (round % 2 == 1)
+			map_ns[0] = std::min(map_ns[0], profiled_map_ns<ft::map<int, int> >(keys));
+	}
+	std::cout << std::setw(36) << "push_back" << std::setw(14) << vector_ns[0] << std::setw(14) << vector_ns[1] << std::endl;
+	std::cout << std::setw(36) << "map insert + find + erase half" << std::setw(14) << map_ns[0] << std::setw(14) << map_ns[1] << std::endl;
+	std::cout << "vector profile:" << std::endl;
+	vector_profiler::profile().dump(std::cout);
+	std::cout << "map profile:" << std::endl;
+	map_profiler::profile().dump(std::cout);
+	std::cout << "map profile (json):" << std::endl;
+	map_profiler::profile().dump_json(std::cout);
+}
+
+// ==================== Main ====================
+struct benchmark
+{
+	const char* name;
+	void (*run)();
+};
+
+static const benchmark benchmarks[] = {
+	{ "size", bench_size },
+	{ "hint", bench_hint },
+	{ "bulk", bench_bulk },
+	{ "copy", bench_copy },
+	{ "pool", bench_pool },
+	{ "node", bench_node },
+	{ "vector", bench_vector },
+	{ "growth", bench_growth },
+	{ "emplace", bench_emplace },
+	{ "small", bench_small },
+	{ "compare", bench_compare },
+	{ "fill", bench_fill },
+	{ "tracing", bench_tracing },
+	{ "tree", bench_tree },
+	{ "profile", bench_profile },
+};
+
+int main(int argc, char** argv)
+{
+	bool found = false;
+	for (size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++)
+	{
+		if (argc > 1 && std::strcmp(argv[1], benchmarks[i].name) != 0)
+			continue;
+		found = true;
+		benchmarks[i].run();
+		std::cout << std::endl;
+	}
+	if (!found)
+	{
+		std::cerr << "Unknown benchmark: " << argv[1] << std::endl;
+		return 1;
+	}
+	return 0;
+}
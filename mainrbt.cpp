@@ -1,32 +1,224 @@
-#include "RedBlackTree.hpp"
+#include "map.hpp"
+#include "PoolAllocator.hpp"
+#include <map>
 #include <iostream>
-#include <random>
+#include <cstdlib>
 
-int main(void)
+/*
+	RedBlackTree stress test (make stress)
+	- seeded random mix of inserts / erases / lookups on an ft::map and a std::map side by side
+	- every result is compared on the spot, after each batch the whole content is compared
+	  && RedBlackTree::verify() checks every tree invariant
+	- same seed = same operations: a failure is reproduced by running the printed seed again
+	./ft_stress [seed] [operations] [key range] [batch size]
+*/
+
+// ==================== Random ====================
+// xorshift: same sequence on every platform
+static unsigned long long g_state;
+
+static unsigned int next_random()
+{
+	g_state ^= g_state << 13;
+	g_state ^= g_state >> 7;
+	g_state ^= g_state << 17;
+	return static_cast<unsigned int>(g_state >> 11);
+}
+
+// ==================== Checks ====================
+static unsigned long g_seed;
+static size_t g_operation;
+
+static bool fail(const char* what)
+{
+	std::cout << "FAILED: " << what << " (seed " << g_seed << ", operation " << g_operation << ")" << std::endl;
+	return false;
+}
+
+template <class Map>
+static bool same_content(const Map& ft_map, const std::map<int, int>& std_map)
 {
-	RedBlackTree<int> tree;
-	std::random_device rd;
-	std::mt19937 gen(rd());
-	std::uniform_int_distribution<> dis(0, 1000);
-	for (int i = 0; i < 1; i++)
+	if (ft_map.size() != std_map.size())
+		return fail("size");
+	std::map<int, int>::const_iterator expected = std_map.begin();
+	for (typename Map::const_iterator it = ft_map.begin(); it != ft_map.end(); ++it, ++expected)
+		if (it->first != expected->first || it->second != expected->second)
+			return fail("content");
+	std::map<int, int>::const_reverse_iterator rexpected = std_map.rbegin();
+	for (typename Map::const_reverse_iterator it = ft_map.rbegin(); it != ft_map.rend(); ++it, ++rexpected)
+		if (it->first != rexpected->first)
+			return fail("reverse content");
+	return ft_map.verify(std::cout) || fail("tree invariants");
+}
+
+template <class Iterator, class StdIterator>
+static bool same_position(Iterator it, Iterator end, StdIterator expected, StdIterator expected_end)
+{
+	if ((it == end) != (expected == expected_end))
+		return false;
+	return it == end || (it->first == expected->first && it->second == expected->second);
+}
+
+// ==================== Operations ====================
+template <class Map>
+static bool random_operation(Map& ft_map, std::map<int, int>& std_map, int key_range)
+{
+	int key = static_cast<int>(next_random() % key_range);
+	int value = static_cast<int>(next_random() % 1000);
+	switch (next_random() % 16)
 	{
-		int num = dis(gen);
-		tree.insert(num);
-		std::cout << "insert " << num << "\n\n";
-		tree.print();
-		1/2 chance to remove the number
-		std::cout << "- 50 % chance to remove " << num << "\n\n";
-		if (dis(gen) % 2 == 0)
+		case 0:
+		case 1:
+		case 2: // insert
+			if (ft_map.insert(ft::make_pair(key, value)).second != std_map.insert(std::make_pair(key, value)).second)
+				return fail("insert");
+			break;
+		case 3: // insert with a hint (good or bad)
 		{
-			tree.remove(num);
-			std::cout << "!!! remove " << num << "\n\n";
-			tree.print();
+			typename Map::iterator hint = (next_random() % 2) ? ft_map.lower_bound(key) : ft_map.begin();
+			typename Map::iterator it = ft_map.insert(hint, ft::make_pair(key, value));
+			std_map.insert(std::make_pair(key, value));
+			if (it->first != key || it->second != std_map[key])
+				return fail("hinted insert");
+			break;
 		}
-		else
-			std::cout << "!!! no remove" << "\n\n";
-		std::cout << "|| END ||" << std::endl;
+		case 4: // emplace / try_emplace / operator[]
+			if (next_random() % 2)
+			{
+				if (ft_map.try_emplace(key, value).second != std_map.insert(std::make_pair(key, value)).second)
+					return fail("try_emplace");
+			}
+			else
+			{
+				ft_map[key] += value;
+				std_map[key] += value;
+			}
+			break;
+		case 5:
+		case 6:
+		case 7: // erase by key
+			if (ft_map.erase(key) != std_map.erase(key))
+				return fail("erase key");
+			break;
+		case 8: // erase by iterator
+		{
+			typename Map::iterator it = ft_map.find(key);
+			if (it != ft_map.end())
+			{
+				ft_map.erase(it);
+				std_map.erase(key);
+			}
+			break;
+		}
+		case 9: // erase a small range
+		{
+			int last_key = key + static_cast<int>(next_random() % 8);
+			ft_map.erase(ft_map.lower_bound(key), ft_map.lower_bound(last_key));
+			std_map.erase(std_map.lower_bound(key), std_map.lower_bound(last_key));
+			break;
+		}
+		case 10:
+		case 11: // find / count
+			if (!same_position(ft_map.find(key), ft_map.end(), std_map.find(key), std_map.end()) || ft_map.count(key) != std_map.count(key))
+				return fail("find");
+			break;
+		case 12:
+		case 13: // bounds
+		{
+			const Map& const_map = ft_map;
+			if (!same_position(ft_map.lower_bound(key), ft_map.end(), std_map.lower_bound(key), std_map.end())
+				|| !same_position(const_map.upper_bound(key), const_map.end(), std_map.upper_bound(key), std_map.end()))
+				return fail("lower_bound / upper_bound");
+			ft::pair<typename Map::iterator, typename Map::iterator> range = ft_map.equal_range(key);
+			if (range.first != ft_map.lower_bound(key) || range.second != ft_map.upper_bound(key))
+				return fail("equal_range");
+			break;
+		}
+		case 14: // walk a few steps from a random position, both ways
+		{
+			typename Map::iterator it = ft_map.lower_bound(key);
+			std::map<int, int>::iterator expected = std_map.lower_bound(key);
+			for (int i = 0; i < 4 && it != ft_map.begin(); i++)
+			{
+				--it;
+				--expected;
+				if (it->first != expected->first)
+					return fail("iterator --");
+			}
+			for (int i = 0; i < 8 && it != ft_map.end(); i++, ++it, ++expected)
+				if (!same_position(it, ft_map.end(), expected, std_map.end()))
+					return fail("iterator ++");
+			break;
+		}
+		default: // rare whole-container operations
+			switch (next_random() % 64)
+			{
+				case 0:
+					ft_map.clear();
+					std_map.clear();
+					break;
+				case 1:
+				{
+					Map copy(ft_map);
+					if (!same_content(copy, std_map))
+						return fail("copy");
+					ft_map.swap(copy);
+					break;
+				}
+				case 2:
+				{
+					Map assigned;
+					assigned = ft_map;
+					ft_map = assigned;
+					break;
+				}
+				case 3:
+				{
+					Map range(ft_map.begin(), ft_map.end());
+					if (!same_content(range, std_map))
+						return fail("range constructor");
+					break;
+				}
+			}
+	}
+	return true;
+}
+
+template <class Map>
+static bool stress(const char* name, size_t operations, int key_range, size_t batch)
+{
+	g_state = 88172645463325252ULL ^ g_seed;
+	Map ft_map;
+	std::map<int, int> std_map;
+	for (g_operation = 1; g_operation <= operations; g_operation++)
+	{
+		if (!random_operation(ft_map, std_map, key_range))
+			return false;
+		if (g_operation % batch == 0 && !same_content(ft_map, std_map))
+			return false;
+	}
+	if (!same_content(ft_map, std_map))
+		return false;
+	std::cout << name << ": " << operations << " operations ok, final size " << ft_map.size() << std::endl;
+	return true;
+}
+
+// ==================== Main ====================
+int main(int argc, char** argv)
+{
+	g_seed = (argc > 1) ? std::strtoul(argv[1], NULL, 10) : 42;
+	size_t operations = (argc > 2) ? std::strtoul(argv[2], NULL, 10) : 2000000;
+	int key_range = (argc > 3) ? std::atoi(argv[3]) : 5000;
+	size_t batch = (argc > 4) ? std::strtoul(argv[4], NULL, 10) : 10000;
+	if (key_range <= 0 || batch == 0)
+	{
+		std::cerr << "usage: " << argv[0] << " [seed] [operations] [key range] [batch size]" << std::endl;
+		return 1;
 	}
-	RedBlackTree<int> tree1(tree);
-	tree1.print();
-	return (0);
-}
\ No newline at end of file
+	std::cout << "seed " << g_seed << ", key range " << key_range << ", verify every " << batch << " operations" << std::endl;
+	if (!stress<ft::map<int, int> >("std::allocator", operations, key_range, batch))
+		return 1;
+	if (!stress<ft::map<int, int, std::less<int>, ft::pool_allocator<ft::pair<const int, int> > > >("pool_allocator", operations, key_range, batch))
+		return 1;
+	return 0;
+}
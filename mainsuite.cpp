@@ -0,0 +1,505 @@
+#include "map.hpp"
+#include "stack.hpp"
+#include "Vector.hpp"
+#include <map>
+#include <stack>
+#include <vector>
+#include <deque>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <time.h>
+
+/*
+	Benchmark suite: every container operation, ft vs std, same inputs for both
+	- each measurement = warmup runs (dropped) + repeated runs -> median and p99 (nearest rank) of ns per operation
+	- keys come from a fixed seed: two runs of the same binary measure the same work
+	./ft_suite [--format=table|csv|json] [--repeats=N] [--warmup=N] [--sizes=N,N,...] [--filter=text]
+	(--filter keeps the benchmarks whose "operation container distribution" line contains text)
+*/
+
+// ==================== Options ====================
+enum format { TABLE, CSV, JSON };
+
+struct options
+{
+	format output;
+	size_t repeats;
+	size_t warmup;
+	std::vector<size_t> sizes;
+	std::string filter;
+};
+
+static options g_options;
+static volatile size_t g_sink = 0; // results land here so that the compiler can't drop the work
+
+static double now_ns()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// ==================== Inputs ====================
+// xorshift: same sequence everywhere, unlike rand()
+static unsigned long long g_state = 88172645463325252ULL;
+static unsigned long long next_random()
+{
+	g_state ^= g_state << 13;
+	g_state ^= g_state >> 7;
+	g_state ^= g_state << 17;
+	return g_state;
+}
+
+// Keys are even (2 * i): odd values are misses for lower_bound
+static std::vector<int> make_keys(size_t n, const std::string& distribution)
+{
+	std::vector<int> keys(n);
+	for (size_t i = 0; i < n; i++)
+		keys[i] = static_cast<int>(2 * i);
+	if (distribution == "reverse")
+		std::reverse(keys.begin(), keys.end());
+	else if (distribution == "random")
+	{
+		g_state = 88172645463325252ULL + n;
+		for (size_t i = n; i > 1; i--)
+			std::swap(keys[i - 1], keys[next_random() % i]);
+	}
+	return keys;
+}
+
+// ==================== Implementations ====================
+struct ft_impl
+{
+	static const char* name() { return "ft"; }
+	typedef ft::vector<int> vector;
+	typedef ft::map<int, int> map;
+	typedef ft::stack<int> stack;
+};
+
+struct std_impl
+{
+	static const char* name() { return "std"; }
+	typedef std::vector<int> vector;
+	typedef std::map<int, int> map;
+	typedef std::stack<int, std::vector<int> > stack;
+};
+
+/*
+	A benchmark is a class template on the implementation with:
+	- a constructor taking the keys (untimed, builds what every run reads)
+	- setup() / teardown() around each run (untimed)
+	- run() -> number of operations done (timed)
+*/
+
+// ==================== vector ====================
+template <class Impl>
+struct vector_push_back
+{
+	const std::vector<int>& keys;
+	typename Impl::vector* v;
+	vector_push_back(const std::vector<int>& k) : keys(k), v(NULL) {}
+	void setup() { v = new typename Impl::vector(); }
+	size_t run()
+	{
+		for (size_t i = 0; i < keys.size(); i++)
+			v->push_back(keys[i]);
+		return keys.size();
+	}
+	void teardown() { delete v; }
+};
+
+// inserts in the middle of a vector of n elements: each one shifts half of the vector
+template <class Impl>
+struct vector_insert
+{
+	static const size_t count = 256;
+	const std::vector<int>& keys;
+	typename Impl::vector* v;
+	vector_insert(const std::vector<int>& k) : keys(k), v(NULL) {}
+	void setup() { v = new typename Impl::vector(keys.begin(), keys.end()); }
+	size_t run()
+	{
+		for (size_t i = 0; i < count; i++)
+			v->insert(v->begin() + v->size() / 2, keys[i % keys.size()]);
+		return count;
+	}
+	void teardown() { delete v; }
+};
+
+template <class Impl>
+struct vector_erase
+{
+	const std::vector<int>& keys;
+	typename Impl::vector* v;
+	size_t count;
+	vector_erase(const std::vector<int>& k) : keys(k), v(NULL), count(std::min(k.size() / 2, static_cast<size_t>(256))) {}
+	void setup() { v = new typename Impl::vector(keys.begin(), keys.end()); }
+	size_t run()
+	{
+		for (size_t i = 0; i < count; i++)
+			v->erase(v->begin() + v->size() / 2);
+		return count;
+	}
+	void teardown() { delete v; }
+};
+
+template <class Impl>
+struct vector_iteration
+{
+	typename Impl::vector v;
+	vector_iteration(const std::vector<int>& k) : v(k.begin(), k.end()) {}
+	void setup() {}
+	size_t run()
+	{
+		size_t sum = 0;
+		for (typename Impl::vector::const_iterator it = v.begin(); it != v.end(); ++it)
+			sum += *it;
+		g_sink = sum;
+		return v.size();
+	}
+	void teardown() {}
+};
+
+template <class Impl>
+struct vector_copy
+{
+	typename Impl::vector v;
+	typename Impl::vector* copy;
+	vector_copy(const std::vector<int>& k) : v(k.begin(), k.end()), copy(NULL) {}
+	void setup() {}
+	size_t run()
+	{
+		copy = new typename Impl::vector(v);
+		return v.size();
+	}
+	void teardown() { delete copy; }
+};
+
+// ==================== map ====================
+template <class Impl>
+struct map_insert
+{
+	const std::vector<int>& keys;
+	typename Impl::map* m;
+	map_insert(const std::vector<int>& k) : keys(k), m(NULL) {}
+	void setup() { m = new typename Impl::map(); }
+	size_t run()
+	{
+		for (size_t i = 0; i < keys.size(); i++)
+			m->insert(typename Impl::map::value_type(keys[i], keys[i]));
+		return keys.size();
+	}
+	void teardown() { delete m; }
+};
+
+template <class Impl>
+struct map_erase
+{
+	const std::vector<int>& keys;
+	typename Impl::map* m;
+	map_erase(const std::vector<int>& k) : keys(k), m(NULL) {}
+	void setup()
+	{
+		m = new typename Impl::map();
+		for (size_t i = 0; i < keys.size(); i++)
+			m->insert(typename Impl::map::value_type(keys[i], keys[i]));
+	}
+	size_t run()
+	{
+		for (size_t i = 0; i < keys.size(); i++)
+			m->erase(keys[i]);
+		return keys.size();
+	}
+	void teardown() { delete m; }
+};
+
+template <class Impl>
+struct map_find
+{
+	const std::vector<int>& keys;
+	typename Impl::map m;
+	map_find(const std::vector<int>& k) : keys(k)
+	{
+		for (size_t i = 0; i < keys.size(); i++)
+			m.insert(typename Impl::map::value_type(keys[i], keys[i]));
+	}
+	void setup() {}
+	size_t run()
+	{
+		size_t found = 0;
+		for (size_t i = 0; i < keys.size(); i++)
+			found += (m.find(keys[i]) != m.end());
+		g_sink = found;
+		return keys.size();
+	}
+	void teardown() {}
+};
+
+// odd keys: never present, lands between two nodes
+template <class Impl>
+struct map_lower_bound
+{
+	const std::vector<int>& keys;
+	typename Impl::map m;
+	map_lower_bound(const std::vector<int>& k) : keys(k)
+	{
+		for (size_t i = 0; i < keys.size(); i++)
+			m.insert(typename Impl::map::value_type(keys[i], keys[i]));
+	}
+	void setup() {}
+	size_t run()
+	{
+		size_t found = 0;
+		for (size_t i = 0; i < keys.size(); i++)
+			found += (m.lower_bound(keys[i] + 1) != m.end());
+		g_sink = found;
+		return keys.size();
+	}
+	void teardown() {}
+};
+
+template <class Impl>
+struct map_iteration
+{
+	typename Impl::map m;
+	map_iteration(const std::vector<int>& k)
+	{
+		for (size_t i = 0; i < k.size(); i++)
+			m.insert(typename Impl::map::value_type(k[i], k[i]));
+	}
+	void setup() {}
+	size_t run()
+	{
+		size_t sum = 0;
+		for (typename Impl::map::const_iterator it = m.begin(); it != m.end(); ++it)
+			sum += it->second;
+		g_sink = sum;
+		return m.size();
+	}
+	void teardown() {}
+};
+
+template <class Impl>
+struct map_copy
+{
+	typename Impl::map m;
+	typename Impl::map* copy;
+	map_copy(const std::vector<int>& k) : copy(NULL)
+	{
+		for (size_t i = 0; i < k.size(); i++)
+			m.insert(typename Impl::map::value_type(k[i], k[i]));
+	}
+	void setup() {}
+	size_t run()
+	{
+		copy = new typename Impl::map(m);
+		return m.size();
+	}
+	void teardown() { delete copy; }
+};
+
+// ==================== stack ====================
+template <class Impl>
+struct stack_push_pop
+{
+	const std::vector<int>& keys;
+	typename Impl::stack* s;
+	stack_push_pop(const std::vector<int>& k) : keys(k), s(NULL) {}
+	void setup() { s = new typename Impl::stack(); }
+	size_t run()
+	{
+		for (size_t i = 0; i < keys.size(); i++)
+			s->push(keys[i]);
+		size_t sum = 0;
+		while (!s->empty())
+		{
+			sum += s->top();
+			s->pop();
+		}
+		g_sink = sum;
+		return 2 * keys.size();
+	}
+	void teardown() { delete s; }
+};
+
+// ==================== Measurement ====================
+struct stats
+{
+	bool measured; // false when the benchmark has nothing to do at this size (ex: erasing half of 1 element)
+	double median;
+	double p99;
+};
+
+template <class Bench>
+static stats measure(const std::vector<int>& keys)
+{
+	Bench bench(keys);
+	std::vector<double> samples;
+	stats result;
+	result.measured = false;
+	for (size_t i = 0; i < g_options.warmup + g_options.repeats; i++)
+	{
+		bench.setup();
+		double start = now_ns();
+		size_t ops = bench.run();
+		double ns = (now_ns() - start) / ops;
+		bench.teardown();
+		if (ops == 0) // no time per operation (inf / nan): skipped
+			return result;
+		if (i >= g_options.warmup)
+			samples.push_back(ns);
+	}
+	std::sort(samples.begin(), samples.end());
+	result.measured = true;
+	size_t n = samples.size();
+	result.median = (n % 2) ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+	result.p99 = samples[std::min(n - 1, (99 * n + 99) / 100 - 1)];
+	return result;
+}
+
+// ==================== Report ====================
+static size_t g_reported = 0;
+
+static void report(const char* operation, const char* container, const char* distribution, size_t size, const char* impl, const stats& s)
+{
+	if (!s.measured)
+		return;
+	if (g_options.output == CSV)
+	{
+		if (g_reported == 0)
+			std::cout << "operation,container,distribution,size,impl,median_ns,p99_ns,repeats" << std::endl;
+		std::cout << operation << ',' << container << ',' << distribution << ',' << size << ',' << impl << ','
+			<< std::fixed << std::setprecision(3) << s.median << ',' << s.p99 << ',' << g_options.repeats << std::endl;
+	}
+	else if (g_options.output == JSON)
+	{
+		std::cout << ((g_reported == 0) ? "[\n" : ",\n")
+			<< "  {\"operation\": \"" << operation << "\", \"container\": \"" << container << "\", \"distribution\": \"" << distribution
+			<< "\", \"size\": " << size << ", \"impl\": \"" << impl << "\", \"median_ns\": " << std::fixed << std::setprecision(3) << s.median
+			<< ", \"p99_ns\": " << s.p99 << ", \"repeats\": " << g_options.repeats << "}";
+	}
+	else
+	{
+		if (g_reported == 0)
+			std::cout << std::setw(12) << "operation" << std::setw(8) << "cont." << std::setw(12) << "keys" << std::setw(10) << "size" << std::setw(6) << "impl"
+				<< std::setw(14) << "median ns/op" << std::setw(14) << "p99 ns/op" << std::endl;
+		std::cout << std::setw(12) << operation << std::setw(8) << container << std::setw(12) << distribution << std::setw(10) << size << std::setw(6) << impl
+			<< std::fixed << std::setprecision(2) << std::setw(14) << s.median << std::setw(14) << s.p99 << std::endl;
+	}
+	g_reported++;
+}
+
+// ft then std on the same keys
+template <template <class> class Bench>
+static void compare(const char* operation, const char* container, const char* distribution)
+{
+	std::string line = std::string(operation) + " " + container + " " + distribution;
+	if (line.find(g_options.filter) == std::string::npos)
+		return;
+	for (size_t i = 0; i < g_options.sizes.size(); i++)
+	{
+		std::vector<int> keys = make_keys(g_options.sizes[i], distribution);
+		report(operation, container, distribution, keys.size(), ft_impl::name(), measure<Bench<ft_impl> >(keys));
+		report(operation, container, distribution, keys.size(), std_impl::name(), measure<Bench<std_impl> >(keys));
+	}
+}
+
+static void run_suite()
+{
+	compare<vector_push_back>("push_back", "vector", "sequential");
+	compare<vector_insert>("insert", "vector", "sequential");
+	compare<vector_erase>("erase", "vector", "sequential");
+	compare<vector_iteration>("iteration", "vector", "sequential");
+	compare<vector_copy>("copy", "vector", "sequential");
+	const char* distributions[] = { "sequential", "reverse", "random" };
+	for (size_t d = 0; d < 3; d++)
+	{
+		compare<map_insert>("insert", "map", distributions[d]);
+		compare<map_erase>("erase", "map", distributions[d]);
+		compare<map_find>("find", "map", distributions[d]);
+		compare<map_lower_bound>("lower_bound", "map", distributions[d]);
+	}
+	compare<map_iteration>("iteration", "map", "random");
+	compare<map_copy>("copy", "map", "random");
+	compare<stack_push_pop>("push_pop", "stack", "sequential");
+	if (g_options.output == JSON)
+		std::cout << ((g_reported == 0) ? "[]" : "\n]") << std::endl;
+}
+
+// ==================== Main ====================
+static bool parse_size(const char* text, size_t& value)
+{
+	char* end;
+	unsigned long n = std::strtoul(text, &end, 10);
+	if (end == text || n == 0)
+		return false;
+	value = n;
+	return true;
+}
+
+static bool parse_options(int argc, char** argv)
+{
+	g_options.output = TABLE;
+	g_options.repeats = 15;
+	g_options.warmup = 2;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg(argv[i]);
+		if (arg == "--format=table")
+			g_options.output = TABLE;
+		else if (arg == "--format=csv")
+			g_options.output = CSV;
+		else if (arg == "--format=json")
+			g_options.output = JSON;
+		else if (arg.compare(0, 10, "--repeats=") == 0)
+		{
+			if (!parse_size(argv[i] + 10, g_options.repeats))
+				return false;
+		}
+		else if (arg.compare(0, 9, "--warmup=") == 0)
+		{
+			std::istringstream in(arg.substr(9));
+			if (!(in >> g_options.warmup))
+				return false;
+		}
+		else if (arg.compare(0, 8, "--sizes=") == 0)
+		{
+			std::istringstream in(arg.substr(8));
+			std::string item;
+			while (std::getline(in, item, ','))
+			{
+				size_t n;
+				if (!parse_size(item.c_str(), n))
+					return false;
+				g_options.sizes.push_back(n);
+			}
+		}
+		else if (arg.compare(0, 9, "--filter=") == 0)
+			g_options.filter = arg.substr(9);
+		else
+			return false;
+	}
+	if (g_options.sizes.empty())
+	{
+		g_options.sizes.push_back(1000);
+		g_options.sizes.push_back(10000);
+		g_options.sizes.push_back(100000);
+	}
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	if (!parse_options(argc, argv))
+	{
+		std::cerr << "usage: " << argv[0] << " [--format=table|csv|json] [--repeats=N] [--warmup=N] [--sizes=N,N,...] [--filter=text]" << std::endl;
+		return 1;
+	}
+	run_suite();
+	return 0;
+}
@@ -0,0 +1,138 @@
+#include "Vector.hpp"
+#include "SmallVector.hpp"
+#include "map.hpp"
+#include "TracingAllocator.hpp"
+#include <string>
+#include <iostream>
+#include <cstdlib>
+#include <limits>
+
+/*
+	ft::vector / ft::map leak check
+	- the vector buffer && every string buffer go through counting_allocator
+	- 10^6 insertions in the middle of the vector (+ erases to keep it small), with every insert / erase flavour
+	- once the vector is gone, every construct must have its destroy && every allocate its deallocate
+	- the map records into its own stats: its nodes must all be given back too
+	- a trimming small_vector popped back down must stay in its inline buffer (no heap at all)
+*/
+
+// ==================== Counting allocator ====================
+// default constructed tracing allocators all record into global_allocation_stats()
+template <class T>
+struct counting_allocator
+{
+	typedef ft::tracing_allocator<T> type;
+};
+
+typedef std::basic_string<char, std::char_traits<char>, counting_allocator<char>::type> counted_string;
+typedef ft::vector<counted_string, counting_allocator<counted_string>::type> counted_vector;
+
+// ==================== Workload ====================
+static counted_string make_string(size_t i)
+{
+	counted_string str(32, 'a' + i % 26); // too long for the small string buffer -> heap
+	str[0] = '0' + i % 10;
+	return str;
+}
+
+static void mid_inserts(size_t inserts, size_t max_size)
+{
+	counted_vector v;
+	counted_vector chunk(3, make_string(0));
+	for (size_t i = 0; i < inserts; i++)
+	{
+		size_t middle = v.size() / 2;
+		switch (i % 8)
+		{
+			case 0: // fill
+				v.insert(v.begin() + middle, 2, make_string(i));
+				break;
+			case 1: // range
+				v.insert(v.begin() + middle, chunk.begin(), chunk.end());
+				break;
+			case 2: // element of the vector itself
+				if (!v.empty())
+					v.insert(v.begin() + middle, v[v.size() - 1]);
+				break;
+			default:
+				v.insert(v.begin() + middle, make_string(i));
+		}
+		if (v.size() > max_size)
+		{
+			if (i % 2)
+				v.erase(v.begin() + rand() % v.size());
+			else
+			{
+				size_t first = rand() % (v.size() - 4);
+				v.erase(v.begin() + first, v.begin() + first + 4);
+			}
+		}
+	}
+	std::cout << "final size: " << v.size() << ", capacity: " << v.capacity() << std::endl;
+}
+
+// nodes go through the map allocator rebound to the tree node type
+static bool map_churn(size_t operations)
+{
+	typedef ft::map<int, counted_string, std::less<int>, ft::tracing_allocator<ft::pair<const int, counted_string> > > counted_map;
+	ft::allocation_stats stats;
+	{
+		counted_map::allocator_type alloc(&stats);
+		counted_map m(std::less<int>(), alloc);
+		for (size_t i = 0; i < operations; i++)
+		{
+			int key = rand() % 4096;
+			if (i % 3)
+				m.insert(ft::make_pair(key, make_string(i)));
+			else
+				m.erase(key);
+		}
+		counted_map copy(m);
+		m.clear();
+		m = copy;
+		std::cout << "map size: " << m.size() << ", live bytes: " << stats.live_bytes << ", peak bytes: " << stats.peak_bytes << std::endl;
+	}
+	std::cout << "map allocations: " << stats.allocations << " | deallocations: " << stats.deallocations << " | live bytes: " << stats.live_bytes << std::endl;
+	return stats.balanced() && stats.allocations > 0;
+}
+
+// filled to N then popped: the trim must not move it out of its inline buffer, a spilled one comes back
+static bool small_vector_trim()
+{
+	typedef ft::small_vector<int, 8, ft::tracing_allocator<int>, ft::trimming_growth> trimmed_vector;
+	ft::allocation_stats stats;
+	trimmed_vector v((ft::tracing_allocator<int>(&stats)));
+	for (int i = 0; i < 8; i++)
+		v.push_back(i);
+	while (v.size() > 1)
+		v.pop_back();
+	bool inline_ok = v.is_inline() && v.capacity() == 8 && stats.allocations == 0;
+	for (int i = 0; i < 64; i++)
+		v.push_back(i);
+	while (v.size() > 1)
+		v.pop_back();
+	bool back_ok = v.is_inline() && v.front() == 0 && stats.balanced();
+	std::cout << "trimming small_vector: " << (inline_ok ? "stays inline" : "LEFT ITS INLINE BUFFER") << ", "
+		<< (back_ok ? "back inline after spilling" : "STUCK ON THE HEAP") << " (" << stats.allocations << " heap allocations)" << std::endl;
+	return inline_ok && back_ok;
+}
+
+int main()
+{
+	const size_t inserts = 1000000;
+	srand(42);
+	mid_inserts(inserts, 128);
+	std::cout << "mid-vector inserts: " << inserts << std::endl;
+	const ft::allocation_stats& counters = ft::global_allocation_stats();
+	counters.dump(std::cout);
+	bool map_ok = map_churn(inserts / 4);
+	if (!counters.balanced() || counters.constructs != counters.destroys || !map_ok)
+	{
+		std::cout << "LEAK" << std::endl;
+		return 1;
+	}
+	if (!small_vector_trim())
+		return 1;
+	std::cout << "no leaks" << std::endl;
+	return 0;
+}
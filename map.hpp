@@ -5,6 +5,10 @@
 #include "Pair.hpp"
 #include "RedBlackTree.hpp"
 #include "Equal.hpp"
+#include "EnableIf.hpp"
+#include "IsTransparent.hpp"
+#include "KeyOfValue.hpp"
+#include "LatencyProfiler.hpp"
 #include <memory>
 
 /* map specificities:
@@ -12,10 +16,13 @@
 	- Ordered (by KEY)
 	- Unique (no two equivalent keys)
 	- Allocator-aware
+	- Lookups compare keys only (no value_type temporaries), Compare with is_transparent (ex: ft::transparent_less)
+	  enables find/count/bounds with any type comparable to Key (ex: const char* on a std::string map)
+	- Latency sampling of the operations is a policy (see LatencyProfiler.hpp), off by default
 */
 namespace ft
 {
-	template <class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator<ft::pair<const Key, T> > >
+	template <class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator<ft::pair<const Key, T> >, class Profiler = ft::no_profiler >
 	class map
 	{
 		public:
@@ -23,19 +30,25 @@ namespace ft
 			typedef T mapped_type;
 			typedef ft::pair<const Key, T> value_type;
 			typedef Compare key_compare;
+			// value_comp(): orders pairs with the map's own comparator
 			struct pair_compair
 			{
-				bool operator()(value_type const lhs, value_type const rhs) const
-				{
-					Compare comp;
-					return comp(lhs.first, rhs.first);
-				}
+				Compare comp;
+				pair_compair(const Compare& c = Compare()) : comp(c) {}
+				bool operator()(value_type const &lhs, value_type const &rhs) const { return comp(lhs.first, rhs.first); }
 			};
 		private:
-			typedef RedBlackTree<ft::pair<const Key, T>, pair_compair, Alloc>	_redblacktree;
+			// the tree compares keys directly, pair.first is extracted by reference
+			typedef RedBlackTree<value_type, Compare, Alloc, ft::select_first<value_type> >	_redblacktree;
+			// heterogeneous overloads only exist when Compare is transparent
+			template <class K, class R>
+			struct if_transparent : public ft::enable_if<ft::is_transparent<Compare, K>::value, R> {};
+			// opened at the top of each profiled operation (empty with no_profiler)
+			typedef typename Profiler::scope _profiled;
 		public:
 			typedef pair_compair pair_compair;
 			typedef Alloc allocator_type;
+			typedef Profiler profiler_type;
 			typedef typename allocator_type::reference reference;
 			typedef typename allocator_type::const_reference const_reference;
 			typedef typename allocator_type::pointer pointer;
@@ -55,9 +68,9 @@ namespace ft
 			bool superior(key_type const &lhs, key_type const &rhs) const { return this->_comp(rhs, lhs); }
 		public:
 		// ==================== Constructors / Destructor ====================
-			explicit map(const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type()): _comp(comp), _alloc(alloc), _tree() { }
+			explicit map(const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type()): _comp(comp), _alloc(alloc), _tree(comp, alloc) { }
 			template <class InputIterator>
-			map(InputIterator first, InputIterator last, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type()) : _comp(comp), _alloc(alloc), _tree() { while (first != last) this->_tree.insert(*first++); }
+			map(InputIterator first, InputIterator last, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type()) : _comp(comp), _alloc(alloc), _tree(comp, alloc) { this->_tree.insert_range(first, last); }
 			map(map const &x): _comp(x._comp), _alloc(x._alloc), _tree(x._tree) { }
 			~map() { }
 		// ==================== (=) Operator ====================
@@ -70,17 +83,16 @@ namespace ft
 			}
 		// ==================== ([]) Operator =======================
 			// Insert new element if key exist'nt
-			mapped_type &operator[](key_type const &k)
-			{
-				return ((this->insert(ft::make_pair(k, mapped_type())).first)->second);
-			}
+			mapped_type &operator[](key_type const &k) { return this->try_emplace(k).first->second; }
 		// ==================== Accessors ====================
-			bool empty() const { return _tree.size() == 0; }
+			bool empty() const { return _tree.empty(); }
 			size_type size() const { return _tree.size(); }
 			size_type max_size() const { return _tree.max_size(); }
 			allocator_type get_allocator() const { return this->_alloc; }
 			key_compare key_comp() const { return this->_comp; }
-			pair_compair value_comp() const { return pair_compair(); }
+			pair_compair value_comp() const { return pair_compair(this->_comp); }
+			// Debug: checks every tree invariant, false + reason on out if one is broken (see RedBlackTree::verify)
+			bool verify(std::ostream &out = std::cerr) const { return this->_tree.verify(out); }
 		// ==================== Iterators ====================
 			iterator begin(){ return _tree.begin(); }
 			const_iterator begin() const { return _tree.begin(); }
@@ -105,124 +117,110 @@ namespace ft
 			// insert in all cases
 			ft::pair<iterator, bool> insert(value_type const &val)
 			{
-				bool inserted = this->_tree.insert(val);
-				return ft::make_pair(iterator(this->_tree.find(val)), inserted);
+				_profiled profiled(ft::profile_insert);
+				ft::pair<typename _redblacktree::rb_links*, bool> inserted = this->_tree.insert_unique(val);
+				return ft::make_pair(iterator(inserted.first), inserted.second);
 			}
-			iterator insert(iterator position, value_type const &val) { (void)position; return this->insert(val).first; }
+			// position is only a hint: right next to it the insertion skips the descent from the root
+			iterator insert(iterator position, value_type const &val) { _profiled profiled(ft::profile_insert); return iterator(this->_tree.insert_unique(position.node(), val).first); }
 			template <class InputIterator>
-			void insert(InputIterator first, InputIterator last) { while (first != last) this->insert(*first++); }
+			void insert(InputIterator first, InputIterator last) { _profiled profiled(ft::profile_insert); this->_tree.insert_range(first, last); }
+			// Emplace: value_type(args...) built in its node (C++98: up to 3 arguments, see EmplaceArgs.hpp)
+			template <class A1>
+			ft::pair<iterator, bool> emplace(const A1 &a1) { _profiled profiled(ft::profile_insert); return this->make_result(this->_tree.emplace_unique(ft::emplace_args1<A1>(a1))); }
+			template <class A1, class A2>
+			ft::pair<iterator, bool> emplace(const A1 &a1, const A2 &a2) { _profiled profiled(ft::profile_insert); return this->make_result(this->_tree.emplace_unique(ft::emplace_args2<A1, A2>(a1, a2))); }
+			template <class A1, class A2, class A3>
+			ft::pair<iterator, bool> emplace(const A1 &a1, const A2 &a2, const A3 &a3) { _profiled profiled(ft::profile_insert); return this->make_result(this->_tree.emplace_unique(ft::emplace_args3<A1, A2, A3>(a1, a2, a3))); }
+			// Try emplace: key present -> nothing built, otherwise mapped_type(args...) built in the node next to a copy of k
+			ft::pair<iterator, bool> try_emplace(const key_type &k) { return this->try_emplace_args(k, ft::emplace_args0()); }
+			template <class A1>
+			ft::pair<iterator, bool> try_emplace(const key_type &k, const A1 &a1) { return this->try_emplace_args(k, ft::emplace_args1<A1>(a1)); }
+			template <class A1, class A2>
+			ft::pair<iterator, bool> try_emplace(const key_type &k, const A1 &a1, const A2 &a2) { return this->try_emplace_args(k, ft::emplace_args2<A1, A2>(a1, a2)); }
+			template <class A1, class A2, class A3>
+			ft::pair<iterator, bool> try_emplace(const key_type &k, const A1 &a1, const A2 &a2, const A3 &a3) { return this->try_emplace_args(k, ft::emplace_args3<A1, A2, A3>(a1, a2, a3)); }
 			size_type erase(key_type const &k)
 			{
-				size_type erased_count = 0;
-				value_type tmp(k, mapped_type());
-				if (this->_tree.find(tmp) != NULL)
-				{
-					this->_tree.remove(tmp);
-					erased_count = 1;
-				}
-				return erased_count;
+				_profiled profiled(ft::profile_erase);
+				typename _redblacktree::rb_links* node = this->_tree.find(k);
+				if (node == NULL)
+					return 0;
+				this->_tree.remove(node);
+				return 1;
 			}
-			void erase(iterator position) { this->_tree.remove(*position); }
+			void erase(iterator position) { _profiled profiled(ft::profile_erase); this->_tree.remove(position.node()); }
 			// save next node before erase
 			void erase(iterator first, iterator last)
 			{
+				_profiled profiled(ft::profile_erase);
 				iterator next;
 				while (first != last)
 				{
 					next = first;
 					++first;
-					this->_tree.remove(*next);
+					this->_tree.remove(next.node());
 				}
 			}
 		// ===================== Find =======================
 			// Search for element associated with key
-			iterator find(const key_type &key)
-			{
-				value_type val(key, mapped_type());
-				typename _redblacktree::rb_node* value;
-				value = _tree.find(val);
-				if (value == NULL)
-					return this->end();
-				else
-					return iterator(value);
-			}
-			const_iterator find(const key_type &key) const
-			{
-				value_type val(key, mapped_type());
-				typename _redblacktree::rb_node* value;
-				value = _tree.find(val);
-				if (value == NULL)
-					return this->end();
-				else
-					return const_iterator(value);
-			}
+			iterator find(const key_type &key) { _profiled profiled(ft::profile_find); return this->make_iterator(this->_tree.find(key)); }
+			const_iterator find(const key_type &key) const { _profiled profiled(ft::profile_find); return this->make_const_iterator(this->_tree.find(key)); }
+			template <class K>
+			typename if_transparent<K, iterator>::type find(const K &key) { _profiled profiled(ft::profile_find); return this->make_iterator(this->_tree.find(key)); }
+			template <class K>
+			typename if_transparent<K, const_iterator>::type find(const K &key) const { _profiled profiled(ft::profile_find); return this->make_const_iterator(this->_tree.find(key)); }
 			// 1 if element is found, 0 otherwise
-			size_type count(const key_type &key) const
-			{
-				value_type val(key, mapped_type());
-				if (_tree.find(val) == NULL)
-					return 0;
-				else
-					return 1;
-			}
+			size_type count(const key_type &key) const { _profiled profiled(ft::profile_find); return this->_tree.find(key) != NULL; }
+			template <class K>
+			typename if_transparent<K, size_type>::type count(const K &key) const { _profiled profiled(ft::profile_find); return this->_tree.find(key) != NULL; }
 			// simple explanation: if the key is not found, the lower bound is the first element that is greater than the key
-			iterator lower_bound(const key_type& key)
-			{
-				typename _redblacktree::rb_node* curr = this->_tree.first();		
-				while (curr != NULL && this->inferior(curr->data.first, key))
-					curr = _redblacktree::successor_in_order(curr);
-				if (curr == NULL || curr == this->_tree.getNil())
-					return (this->end());
-				return (iterator(curr));
-			}
-			const_iterator lower_bound(const key_type& key) const
-			{
-				typename _redblacktree::rb_node* curr = this->_tree.first();	
-				while (curr != NULL && this->inferior(curr->data.first, key))
-					curr = _redblacktree::successor_in_order(curr);
-				if (curr == NULL || curr == this->_tree.getNil())
-					return (this->end());
-				return (const_iterator(curr));
-			}
-			iterator upper_bound(const key_type& key)
-			{
-				typename _redblacktree::rb_node* curr = this->_tree.first();		
-				while (curr != NULL && !this->inferior(key, curr->data.first))
-					curr = _redblacktree::successor_in_order(curr);
-				if (curr == NULL || curr == this->_tree.getNil())
-					return (this->end());
-				return (iterator(curr));
-			}
-			const_iterator upper_bound(const key_type& key) const
-			{
-				
-				typename _redblacktree::rb_node* curr = this->_tree.first();			
-				while (curr != NULL && !this->inferior(key, curr->data.first))
-					curr = _redblacktree::successor_in_order(curr);
-				if (curr == NULL || curr == this->_tree.getNil())
-					return (this->end());
-				return (const_iterator(curr));
-			}
-			ft::pair<iterator, iterator> equal_range(const key_type& key)
-			{
-				return (ft::make_pair(this->lower_bound(key), this->upper_bound(key)));
-			}
-			ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+			iterator lower_bound(const key_type& key) { _profiled profiled(ft::profile_bound); return iterator(this->_tree.lower_bound(key)); }
+			const_iterator lower_bound(const key_type& key) const { _profiled profiled(ft::profile_bound); return const_iterator(this->_tree.lower_bound(key)); }
+			template <class K>
+			typename if_transparent<K, iterator>::type lower_bound(const K& key) { _profiled profiled(ft::profile_bound); return iterator(this->_tree.lower_bound(key)); }
+			template <class K>
+			typename if_transparent<K, const_iterator>::type lower_bound(const K& key) const { _profiled profiled(ft::profile_bound); return const_iterator(this->_tree.lower_bound(key)); }
+			// first element that is strictly greater than the key
+			iterator upper_bound(const key_type& key) { _profiled profiled(ft::profile_bound); return iterator(this->_tree.upper_bound(key)); }
+			const_iterator upper_bound(const key_type& key) const { _profiled profiled(ft::profile_bound); return const_iterator(this->_tree.upper_bound(key)); }
+			template <class K>
+			typename if_transparent<K, iterator>::type upper_bound(const K& key) { _profiled profiled(ft::profile_bound); return iterator(this->_tree.upper_bound(key)); }
+			template <class K>
+			typename if_transparent<K, const_iterator>::type upper_bound(const K& key) const { _profiled profiled(ft::profile_bound); return const_iterator(this->_tree.upper_bound(key)); }
+			ft::pair<iterator, iterator> equal_range(const key_type& key) { _profiled profiled(ft::profile_bound); return make_range<iterator>(this->_tree.equal_range(key)); }
+			ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { _profiled profiled(ft::profile_bound); return make_range<const_iterator>(this->_tree.equal_range(key)); }
+			template <class K>
+			typename if_transparent<K, ft::pair<iterator, iterator> >::type equal_range(const K& key) { _profiled profiled(ft::profile_bound); return make_range<iterator>(this->_tree.equal_range(key)); }
+			template <class K>
+			typename if_transparent<K, ft::pair<const_iterator, const_iterator> >::type equal_range(const K& key) const { _profiled profiled(ft::profile_bound); return make_range<const_iterator>(this->_tree.equal_range(key)); }
+		private:
+			template <class Args>
+			ft::pair<iterator, bool> try_emplace_args(const key_type &k, const Args &args)
 			{
-				return (ft::make_pair(this->lower_bound(key), this->upper_bound(key)));
+				_profiled profiled(ft::profile_insert);
+				const ft::piecewise_construct_t tag = ft::piecewise_construct_t(); // pair_args only keeps a reference: must outlive it
+				ft::emplace_args3<key_type, Args, ft::piecewise_construct_t> pair_args(k, args, tag);
+				return this->make_result(this->_tree.emplace_unique_key(k, pair_args));
 			}
+			ft::pair<iterator, bool> make_result(const ft::pair<typename _redblacktree::rb_links*, bool>& result) { return ft::make_pair(iterator(result.first), result.second); }
+			// tree search results (NULL = not found) -> iterators
+			iterator make_iterator(typename _redblacktree::rb_links* node) { return node == NULL ? this->end() : iterator(node); }
+			const_iterator make_const_iterator(typename _redblacktree::rb_links* node) const { return node == NULL ? this->end() : const_iterator(node); }
+			template <class Iterator>
+			static ft::pair<Iterator, Iterator> make_range(const ft::pair<typename _redblacktree::rb_links*, typename _redblacktree::rb_links*>& range) { return ft::make_pair(Iterator(range.first), Iterator(range.second)); }
 	};
-	template <class Key, class T, class Compare, class Alloc>
-	void swap(ft::map<Key, T, Compare, Alloc> &x, ft::map<Key, T, Compare, Alloc> &y) { x.swap(y); }
-	template <class Key, class T, class Compare, class Alloc>
-	bool operator==(const ft::map<Key, T, Compare, Alloc> &lhs, const ft::map<Key, T, Compare, Alloc> &rhs) { return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()); }
-	template <class Key, class T, class Compare, class Alloc>
-	bool operator!=(const ft::map<Key, T, Compare, Alloc> &lhs, const ft::map<Key, T, Compare, Alloc> &rhs) { return !(lhs == rhs); }
-	template <class Key, class T, class Compare, class Alloc>
-	bool operator<(const ft::map<Key, T, Compare, Alloc> &lhs, const ft::map<Key, T, Compare, Alloc> &rhs)
+	template <class Key, class T, class Compare, class Alloc, class Profiler>
+	void swap(ft::map<Key, T, Compare, Alloc, Profiler> &x, ft::map<Key, T, Compare, Alloc, Profiler> &y) { x.swap(y); }
+	template <class Key, class T, class Compare, class Alloc, class Profiler>
+	bool operator==(const ft::map<Key, T, Compare, Alloc, Profiler> &lhs, const ft::map<Key, T, Compare, Alloc, Profiler> &rhs) { return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()); }
+	template <class Key, class T, class Compare, class Alloc, class Profiler>
+	bool operator!=(const ft::map<Key, T, Compare, Alloc, Profiler> &lhs, const ft::map<Key, T, Compare, Alloc, Profiler> &rhs) { return !(lhs == rhs); }
+	template <class Key, class T, class Compare, class Alloc, class Profiler>
+	bool operator<(const ft::map<Key, T, Compare, Alloc, Profiler> &lhs, const ft::map<Key, T, Compare, Alloc, Profiler> &rhs)
 	{
-		typename ft::map<Key, T, Compare, Alloc>::const_iterator it1 = lhs.begin();
-		typename ft::map<Key, T, Compare, Alloc>::const_iterator it2 = rhs.begin();
+		typename ft::map<Key, T, Compare, Alloc, Profiler>::const_iterator it1 = lhs.begin();
+		typename ft::map<Key, T, Compare, Alloc, Profiler>::const_iterator it2 = rhs.begin();
 		while (it1 != lhs.end() && it2 != rhs.end())
 		{
 			if (*it1 < *it2)
@@ -236,11 +234,11 @@ namespace ft
 			return true;
 		return false;
 	}
-	template <class Key, class T, class Compare, class Alloc>
-	bool operator<=(const ft::map<Key, T, Compare, Alloc> &lhs, const ft::map<Key, T, Compare, Alloc> &rhs) { return !(rhs < lhs); }
-	template <class Key, class T, class Compare, class Alloc>
-	bool operator>(const ft::map<Key, T, Compare, Alloc> &lhs, const ft::map<Key, T, Compare, Alloc> &rhs) { return rhs < lhs; }
-	template <class Key, class T, class Compare, class Alloc>
-	bool operator>=(const ft::map<Key, T, Compare, Alloc> &lhs, const ft::map<Key, T, Compare, Alloc> &rhs) { return !(lhs < rhs); }
+	template <class Key, class T, class Compare, class Alloc, class Profiler>
+	bool operator<=(const ft::map<Key, T, Compare, Alloc, Profiler> &lhs, const ft::map<Key, T, Compare, Alloc, Profiler> &rhs) { return !(rhs < lhs); }
+	template <class Key, class T, class Compare, class Alloc, class Profiler>
+	bool operator>(const ft::map<Key, T, Compare, Alloc, Profiler> &lhs, const ft::map<Key, T, Compare, Alloc, Profiler> &rhs) { return rhs < lhs; }
+	template <class Key, class T, class Compare, class Alloc, class Profiler>
+	bool operator>=(const ft::map<Key, T, Compare, Alloc, Profiler> &lhs, const ft::map<Key, T, Compare, Alloc, Profiler> &rhs) { return !(lhs < rhs); }
 }
 #endif
\ No newline at end of file
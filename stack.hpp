@@ -2,7 +2,7 @@
 #define STACK_HPP
 
 #pragma once
-#include "vector.hpp"
+#include "Vector.hpp"
 #include <memory>
 
 // stack is just a cringe way to use vector, don't use it please it's bad
@@ -1,29 +1,25 @@
-function test_with_std() {
-	echo "compiling with std"
-	clang++ -Wall -Wextra -Werror -std=c++98 main.cpp -DSTD -o test_std
-}
-function test_with_no_std() 
-{
-	echo "compiling with ft"
-	clang++ -Wall -Wextra -Werror -std=c++98 main.cpp -o test_no_std
+# Benchmark suite: ft vs std on every container operation, results saved per commit
+# ./test.sh [table|csv|json] [extra ft_suite options, ex: --sizes=1000,1000000 --repeats=31]
+format=${1:-csv}
+shift
+
+function build() {
+	echo "compiling the suite"
+	make ft_suite || exit 1
 }
-function random() {
-	echo "generating random seed"
-	seed=$RANDOM
-	echo $seed
+function output_file() {
+	commit=$(git rev-parse --short HEAD 2>/dev/null || echo "nogit")
+	if [ "$format" = "table" ]; then
+		results="suite-$commit.txt"
+	else
+		results="suite-$commit.$format"
+	fi
 }
-function timer() {
-	echo "running the two executables, with the same seed"
-	echo "running std"
-	/usr/bin/time ./test_std $seed
-	echo "running ft"
-	/usr/bin/time ./test_no_std $seed
+function run() {
+	echo "running (median / p99 ns per operation) -> $results"
+	./ft_suite --format=$format "$@" > $results || exit 1
 }
 
-test_with_std
-test_with_no_std
-random
-timer
-
-rm test_no_std
-rm test_std
\ No newline at end of file
+build
+output_file
+run "$@"